@@ -44,14 +44,19 @@ set(GEODE_MODS_BEING_BUILT "" CACHE INTERNAL "GEODE_MODS_BEING_BUILT")
 # calling setup_geode_mod if the mod depends on external dependencies that 
 # aren't being built
 function(setup_geode_mod proname)
-    # Get DONT_INSTALL argument
-    set(options DONT_INSTALL)
+    # Get DONT_INSTALL and STRIP_DEBUG_LOGS arguments
+    set(options DONT_INSTALL STRIP_DEBUG_LOGS)
     set(multiValueArgs EXTERNALS)
     cmake_parse_arguments(SETUP_GEODE_MOD "${options}" "" "${multiValueArgs}" ${ARGN})
 
     # Link Geode to the mod
     target_link_libraries(${proname} geode-sdk)
 
+    # Compile out log::debug calls in release builds
+    if (SETUP_GEODE_MOD_STRIP_DEBUG_LOGS)
+        target_compile_definitions(${proname} PRIVATE $<$<CONFIG:Release,MinSizeRel>:GEODE_LOG_MIN_LEVEL=1>)
+    endif()
+
     if (ANDROID)
         if (CMAKE_BUILD_TYPE STREQUAL "Release")
             add_custom_command(
@@ -3,15 +3,17 @@
 // shh, its fine :-)
 #include "sha3.cpp"
 
+#include <algorithm>
 #include <string>
 #include <fstream>
 #include <ciso646>
-#include "picosha2.h"
 #include <vector>
 
 template <class Func>
 void readBuffered(std::ifstream& stream, Func func) {
-    constexpr size_t BUF_SIZE = 4096;
+    // big enough that the stream reads straight into it instead of going
+    // through its own small buffer
+    constexpr size_t BUF_SIZE = 256 * 1024;
     stream.exceptions(std::ios_base::badbit);
     
     std::vector<uint8_t> buffer(BUF_SIZE);
@@ -33,27 +35,40 @@ std::string calculateSHA3_256(std::filesystem::path const& path) {
 }
 
 std::string calculateSHA256(std::filesystem::path const& path) {
-    std::vector<uint8_t> hash(picosha2::k_digest_size);
     std::ifstream file(path, std::ios::binary);
-    picosha2::hash256(file, hash.begin(), hash.end());
-    return picosha2::bytes_to_hex_string(hash.begin(), hash.end());
+    SHA256 sha;
+    readBuffered(file, [&](const void* data, size_t amt) {
+        sha.update(data, amt);
+    });
+    return SHA256::toHex(sha.finish());
 }
 
 std::string calculateSHA256Text(std::filesystem::path const& path) {
-    // remove all newlines
-    std::vector<uint8_t> hash(picosha2::k_digest_size);
+    // remove all newlines; the file is opened in text mode so CRLF is
+    // already turned into LF on Windows
     std::ifstream file(path);
-    std::string text;
-    std::string line;
-    while (std::getline(file, line)) {
-        text += line;
-    }
-    picosha2::hash256(text.begin(), text.end(), hash.begin(), hash.end());
-    return picosha2::bytes_to_hex_string(hash.begin(), hash.end());
+    SHA256 sha;
+    readBuffered(file, [&](const uint8_t* data, size_t amt) {
+        auto end = data + amt;
+        while (data != end) {
+            auto newline = std::find(data, end, '\n');
+            sha.update(data, newline - data);
+            data = newline == end ? end : newline + 1;
+        }
+    });
+    return SHA256::toHex(sha.finish());
 }
 
 std::string calculateHash(std::span<const uint8_t> data) {
-    std::vector<uint8_t> hash(picosha2::k_digest_size);
-    picosha2::hash256(data.begin(), data.end(), hash);
-    return picosha2::bytes_to_hex_string(hash.begin(), hash.end());
-}
\ No newline at end of file
+    SHA256 sha;
+    sha.update(data.data(), data.size());
+    return SHA256::toHex(sha.finish());
+}
+
+void SHA256Hasher::update(std::span<const uint8_t> data) {
+    m_hasher.update(data.data(), data.size());
+}
+
+std::string SHA256Hasher::finish() {
+    return SHA256::toHex(m_hasher.finish());
+}
@@ -4,6 +4,8 @@
 #include <filesystem>
 #include <span>
 
+#include "sha256.hpp"
+
 std::string calculateSHA3_256(std::filesystem::path const& path);
 
 std::string calculateSHA256(std::filesystem::path const& path);
@@ -15,3 +17,20 @@ std::string calculateSHA256Text(std::filesystem::path const& path);
  * used for verifying mods.
  */
 std::string calculateHash(std::span<const uint8_t> data);
+
+/**
+ * Calculates the SHA256 hash of data that arrives in pieces, like a
+ * download, without needing all of it in memory at once
+ */
+class SHA256Hasher final {
+private:
+    SHA256 m_hasher;
+
+public:
+    void update(std::span<const uint8_t> data);
+    /**
+     * Get the hash of everything passed to `update` so far; the hasher
+     * can't be updated after this
+     */
+    std::string finish();
+};
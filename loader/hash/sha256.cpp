@@ -0,0 +1,298 @@
+#include "sha256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define GEODE_SHA256_X86
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+    // clang-cl needs the target attribute just like clang does, only plain
+    // MSVC allows intrinsics without it
+    #if defined(__GNUC__) || defined(__clang__)
+        #define GEODE_SHA256_X86_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+    #else
+        #define GEODE_SHA256_X86_TARGET
+    #endif
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+    // only used when the build targets CPUs that are guaranteed to have the
+    // crypto extensions (like Apple Silicon), so there's nothing to detect
+    #define GEODE_SHA256_ARM
+    #include <arm_neon.h>
+#endif
+
+namespace {
+    constexpr uint32_t INITIAL_STATE[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+
+    alignas(16) constexpr uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+    };
+
+    constexpr uint32_t rotr(uint32_t x, int n) {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    uint32_t loadBigEndian(const uint8_t* data) {
+        return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+    }
+
+    void transformPortable(uint32_t state[8], const uint8_t* data, size_t blocks) {
+        for (; blocks > 0; blocks -= 1, data += SHA256::BLOCK_SIZE) {
+            uint32_t w[64];
+            for (int i = 0; i < 16; i += 1) {
+                w[i] = loadBigEndian(data + i * 4);
+            }
+            for (int i = 16; i < 64; i += 1) {
+                auto s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                auto s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            auto a = state[0], b = state[1], c = state[2], d = state[3];
+            auto e = state[4], f = state[5], g = state[6], h = state[7];
+            for (int i = 0; i < 64; i += 1) {
+                auto t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+                auto t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                h = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+            state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+            state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        }
+    }
+
+#ifdef GEODE_SHA256_X86
+    bool hasShaNi() {
+    #ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuidex(info, 1, 0);
+        bool sse = (info[2] & (1 << 9)) && (info[2] & (1 << 19));
+        __cpuidex(info, 7, 0);
+        return sse && (info[1] & (1 << 29));
+    #else
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+        bool sse = (ecx & bit_SSSE3) && (ecx & bit_SSE4_1);
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+        return sse && (ebx & bit_SHA);
+    #endif
+    }
+
+    // The state is kept as ABEF and CDGH, which is what sha256rnds2 works on
+    #define GEODE_SHA256_ROUNDS(group, msg, prev, next)                                            \
+        tmp = _mm_add_epi32(msg, _mm_load_si128(reinterpret_cast<const __m128i*>(&K[group * 4]))); \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, tmp);                                       \
+        if constexpr (group >= 3 && group <= 14) {                                                 \
+            next = _mm_add_epi32(next, _mm_alignr_epi8(msg, prev, 4));                             \
+            next = _mm_sha256msg2_epu32(next, msg);                                                \
+        }                                                                                          \
+        tmp = _mm_shuffle_epi32(tmp, 0x0e);                                                        \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, tmp);                                       \
+        if constexpr (group >= 1 && group <= 12) {                                                 \
+            prev = _mm_sha256msg1_epu32(prev, msg);                                                \
+        }
+
+    GEODE_SHA256_X86_TARGET
+    void transformShaNi(uint32_t state[8], const uint8_t* data, size_t blocks) {
+        const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+
+        auto tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xb1);
+        auto state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1b);
+        auto state0 = _mm_alignr_epi8(tmp, state1, 8);
+        state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+        for (; blocks > 0; blocks -= 1, data += SHA256::BLOCK_SIZE) {
+            auto saved0 = state0;
+            auto saved1 = state1;
+
+            auto msg0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0)), byteSwap);
+            auto msg1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), byteSwap);
+            auto msg2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), byteSwap);
+            auto msg3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), byteSwap);
+
+            GEODE_SHA256_ROUNDS(0, msg0, msg3, msg1)
+            GEODE_SHA256_ROUNDS(1, msg1, msg0, msg2)
+            GEODE_SHA256_ROUNDS(2, msg2, msg1, msg3)
+            GEODE_SHA256_ROUNDS(3, msg3, msg2, msg0)
+            GEODE_SHA256_ROUNDS(4, msg0, msg3, msg1)
+            GEODE_SHA256_ROUNDS(5, msg1, msg0, msg2)
+            GEODE_SHA256_ROUNDS(6, msg2, msg1, msg3)
+            GEODE_SHA256_ROUNDS(7, msg3, msg2, msg0)
+            GEODE_SHA256_ROUNDS(8, msg0, msg3, msg1)
+            GEODE_SHA256_ROUNDS(9, msg1, msg0, msg2)
+            GEODE_SHA256_ROUNDS(10, msg2, msg1, msg3)
+            GEODE_SHA256_ROUNDS(11, msg3, msg2, msg0)
+            GEODE_SHA256_ROUNDS(12, msg0, msg3, msg1)
+            GEODE_SHA256_ROUNDS(13, msg1, msg0, msg2)
+            GEODE_SHA256_ROUNDS(14, msg2, msg1, msg3)
+            GEODE_SHA256_ROUNDS(15, msg3, msg2, msg0)
+
+            state0 = _mm_add_epi32(state0, saved0);
+            state1 = _mm_add_epi32(state1, saved1);
+        }
+
+        tmp = _mm_shuffle_epi32(state0, 0x1b);
+        state1 = _mm_shuffle_epi32(state1, 0xb1);
+        state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+        state1 = _mm_alignr_epi8(state1, tmp, 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+    }
+
+    #undef GEODE_SHA256_ROUNDS
+#endif
+
+#ifdef GEODE_SHA256_ARM
+    void transformArm(uint32_t state[8], const uint8_t* data, size_t blocks) {
+        auto state0 = vld1q_u32(&state[0]);
+        auto state1 = vld1q_u32(&state[4]);
+
+        for (; blocks > 0; blocks -= 1, data += SHA256::BLOCK_SIZE) {
+            auto saved0 = state0;
+            auto saved1 = state1;
+
+            uint32x4_t msg[4];
+            for (int i = 0; i < 4; i += 1) {
+                msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+            }
+            for (int group = 0; group < 16; group += 1) {
+                auto& current = msg[group % 4];
+                auto tmp = vaddq_u32(current, vld1q_u32(&K[group * 4]));
+                // the words for 4 groups later replace the ones just used
+                if (group < 12) {
+                    current = vsha256su1q_u32(
+                        vsha256su0q_u32(current, msg[(group + 1) % 4]),
+                        msg[(group + 2) % 4], msg[(group + 3) % 4]
+                    );
+                }
+                auto prev0 = state0;
+                state0 = vsha256hq_u32(state0, state1, tmp);
+                state1 = vsha256h2q_u32(state1, prev0, tmp);
+            }
+
+            state0 = vaddq_u32(state0, saved0);
+            state1 = vaddq_u32(state1, saved1);
+        }
+
+        vst1q_u32(&state[0], state0);
+        vst1q_u32(&state[4], state1);
+    }
+#endif
+
+    struct BackendInfo {
+        SHA256::Backend transform;
+        std::string_view name;
+    };
+
+    BackendInfo const& getBackend() {
+        static BackendInfo backend = []() -> BackendInfo {
+        #if defined(GEODE_SHA256_X86)
+            if (hasShaNi()) {
+                return { &transformShaNi, "sha-ni" };
+            }
+        #elif defined(GEODE_SHA256_ARM)
+            return { &transformArm, "armv8" };
+        #endif
+            return { &transformPortable, "portable" };
+        }();
+        return backend;
+    }
+}
+
+SHA256::SHA256() {
+    std::memcpy(m_state, INITIAL_STATE, sizeof(m_state));
+}
+
+void SHA256::update(const void* data, size_t size) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    auto transform = getBackend().transform;
+    m_length += size;
+
+    if (m_buffered > 0) {
+        auto amount = std::min(size, BLOCK_SIZE - m_buffered);
+        std::memcpy(m_buffer + m_buffered, bytes, amount);
+        m_buffered += amount;
+        bytes += amount;
+        size -= amount;
+        if (m_buffered < BLOCK_SIZE) {
+            return;
+        }
+        transform(m_state, m_buffer, 1);
+        m_buffered = 0;
+    }
+
+    // whole blocks are hashed straight from the input
+    if (size >= BLOCK_SIZE) {
+        auto blocks = size / BLOCK_SIZE;
+        transform(m_state, bytes, blocks);
+        bytes += blocks * BLOCK_SIZE;
+        size -= blocks * BLOCK_SIZE;
+    }
+
+    std::memcpy(m_buffer, bytes, size);
+    m_buffered = size;
+}
+
+SHA256::Digest SHA256::finish() {
+    auto transform = getBackend().transform;
+    auto bitLength = m_length * 8;
+
+    m_buffer[m_buffered++] = 0x80;
+    if (m_buffered > BLOCK_SIZE - 8) {
+        std::memset(m_buffer + m_buffered, 0, BLOCK_SIZE - m_buffered);
+        transform(m_state, m_buffer, 1);
+        m_buffered = 0;
+    }
+    std::memset(m_buffer + m_buffered, 0, BLOCK_SIZE - 8 - m_buffered);
+    for (int i = 0; i < 8; i += 1) {
+        m_buffer[BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(bitLength >> (i * 8));
+    }
+    transform(m_state, m_buffer, 1);
+    m_buffered = 0;
+
+    Digest digest;
+    for (int i = 0; i < 8; i += 1) {
+        digest[i * 4 + 0] = static_cast<uint8_t>(m_state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(m_state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(m_state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(m_state[i]);
+    }
+    return digest;
+}
+
+std::string SHA256::toHex(Digest const& digest) {
+    constexpr char HEX[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(digest.size() * 2);
+    for (auto byte : digest) {
+        out += HEX[byte >> 4];
+        out += HEX[byte & 0xf];
+    }
+    return out;
+}
+
+std::string_view SHA256::getBackendName() {
+    return getBackend().name;
+}
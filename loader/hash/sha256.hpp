@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * SHA-256 that uses the CPU's SHA instructions when it has them (SHA-NI on
+ * x86, the crypto extensions on ARMv8) and a portable implementation
+ * otherwise. The backend is picked once, the first time anything is hashed
+ */
+class SHA256 final {
+public:
+    static constexpr size_t BLOCK_SIZE = 64;
+    using Digest = std::array<uint8_t, 32>;
+
+    // compresses `blocks` consecutive 64-byte blocks into the state
+    using Backend = void(*)(uint32_t state[8], const uint8_t* data, size_t blocks);
+
+private:
+    uint32_t m_state[8];
+    uint8_t m_buffer[BLOCK_SIZE];
+    size_t m_buffered = 0;
+    uint64_t m_length = 0;
+
+public:
+    SHA256();
+
+    void update(const void* data, size_t size);
+    /**
+     * Get the hash of everything passed to `update`; the hasher can't be
+     * updated after this
+     */
+    Digest finish();
+
+    static std::string toHex(Digest const& digest);
+
+    /**
+     * Name of the backend in use, "sha-ni", "armv8" or "portable"
+     */
+    static std::string_view getBackendName();
+};
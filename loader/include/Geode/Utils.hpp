@@ -6,6 +6,7 @@
 #include "utils/ranges.hpp"
 #include "utils/casts.hpp"
 #include "utils/cocos.hpp"
+#include "utils/NodeQuery.hpp"
 #include "utils/map.hpp"
 #include "utils/string.hpp"
 #include "utils/file.hpp"
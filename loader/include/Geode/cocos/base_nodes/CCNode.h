@@ -895,6 +895,13 @@ public:
      * @note Geode addition
      */
     GEODE_DLL std::string getID();
+    /**
+     * Get the string ID of this node without copying it
+     * @returns The ID, or an empty string if the node has no ID. The view 
+     * stays valid for as long as the game runs
+     * @note Geode addition
+     */
+    GEODE_DLL std::string_view getIDView();
     /**
      * Set the string ID of this node. String IDs are a Geode addition 
      * that are much safer to use to get nodes than absolute indexes
@@ -923,19 +930,33 @@ public:
 
     /**
      * Get a child based on a query. Searches the child tree for a matching 
-     * child. The query currently only supports the following features:
+     * child. The query supports the following features:
      *  - `node-id`: Match a node with a specific ID
      *  - `node-id-1 node-id-2`: Match a descendant (possibly not immediate) 
      *    child of a node with a specific ID
      *  - `node-id-1 > node-id-2`: Match the immediate child of a node with a 
      *    specific ID 
+     *  - `*`, `:type(ClassName)` and `:index(n)`: see geode::NodeQuery
      * For example, the query "my-layer button-menu > mod.id/epic-button" is 
-     * equivalent to `getChildByIDRecursive("my-layer")
+     * roughly equivalent to `getChildByIDRecursive("my-layer")
      * ->getChildByIDRecursive("button-menu")
      * ->getChildByID("mod.id/epic-button")`
      * @returns The first matching node, or nullptr if none was found
+     * @note Parsed queries are cached, but for queries that run very often 
+     * prefer compiling them once with geode::NodeQuery::compile
      */
     GEODE_DLL CCNode* querySelector(std::string const& query);
+    /**
+     * Get the first child matching a precompiled query
+     * @returns The first matching node, or nullptr if none was found
+     */
+    GEODE_DLL CCNode* querySelector(geode::NodeQuery const& query);
+    /**
+     * Get every child matching a query, in depth-first order
+     * @see querySelector
+     */
+    GEODE_DLL std::vector<CCNode*> querySelectorAll(std::string const& query);
+    GEODE_DLL std::vector<CCNode*> querySelectorAll(geode::NodeQuery const& query);
 
     /** 
      * Removes a child from the container by its ID.
@@ -123,6 +123,8 @@ namespace geode {
     template <class, class>
     class Result;
 
+    class NodeQuery;
+
     namespace modifier {
         class FieldContainer;
 
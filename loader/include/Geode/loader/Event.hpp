@@ -9,6 +9,7 @@
 #include <deque>
 #include <unordered_set>
 #include <atomic>
+#include <typeinfo>
 
 namespace geode {
     class Mod;
@@ -41,18 +42,20 @@ namespace geode {
     
     class GEODE_DLL DefaultEventListenerPool : public EventListenerPool {
     protected:
-        // fix this in Geode 4.0.0
-        struct Data {
-            std::atomic_size_t m_locked = 0;
-            std::mutex m_mutex;
-            std::deque<EventListenerProtocol*> m_listeners;
-            std::vector<EventListenerProtocol*> m_toAdd;
-        };
+        // Listeners are bucketed by the type of event they handle, so 
+        // posting an event only goes through the listeners that can 
+        // actually match it; the details are in Event.cpp
+        struct Data;
         std::unique_ptr<Data> m_data;
 
     private:
         static DefaultEventListenerPool* create();
 
+        // handle() minus handing the event to keyed pools
+        ListenerResult handleListeners(Event* event);
+
+        friend class KeyedEventListenerPool;
+
     public:
         bool add(EventListenerProtocol* listener) override;
         void remove(EventListenerProtocol* listener) override;
@@ -68,6 +71,50 @@ namespace geode {
 
         // todo: make this private in Geode 4.0.0
         DefaultEventListenerPool();
+        ~DefaultEventListenerPool() override;
+    };
+
+    /**
+     * A pool that only holds the listeners for a single key (for example
+     * one specific Task), so posting an event for that key doesn't go
+     * through everyone else's listeners. Events handled by a keyed pool
+     * are passed on to the default pool afterwards, for listeners built
+     * against older headers that registered there instead. Likewise, events
+     * that older code posts straight to the default pool are passed on to 
+     * the keyed pools with listeners for that event type.
+     * Pools only hold a weak reference to their key, and are freed once the
+     * key has been destroyed and nothing is listening anymore
+     */
+    class GEODE_DLL KeyedEventListenerPool final : public DefaultEventListenerPool {
+    protected:
+        // set once this is no longer the pool handed out for its key
+        bool m_released = false;
+        // number of events from the default pool going through this
+        size_t m_pins = 0;
+
+        KeyedEventListenerPool();
+
+        bool isUnused();
+        void drop();
+
+        static ListenerResult handleFromDefault(Event* event);
+
+        friend class DefaultEventListenerPool;
+
+    public:
+        bool add(EventListenerProtocol* listener) override;
+        void remove(EventListenerProtocol* listener) override;
+        ListenerResult handle(Event* event) override;
+
+        /**
+         * Get the pool for a key, creating it if it doesn't exist yet
+         */
+        static KeyedEventListenerPool* get(std::shared_ptr<void const> const& key);
+        /**
+         * Get the pool for a key, or the default pool if nothing is
+         * listening to that key
+         */
+        static EventListenerPool* getForPosting(std::shared_ptr<void const> const& key);
     };
 
     class GEODE_DLL EventListenerProtocol {
@@ -75,8 +122,27 @@ namespace geode {
         EventListenerPool* m_pool = nullptr;
 
     public:
+        using EventMatcher = bool(*)(Event*);
+
         bool enable();
         void disable();
+        /**
+         * Move this listener to the pool `getPool()` currently returns, if 
+         * it's enabled and that isn't the pool it's in. Call this when 
+         * something affecting `getPool()` changes, like the filter
+         */
+        void updatePool();
+
+        /**
+         * Tell pools what type of event this listener handles, so ones that 
+         * support it (like DefaultEventListenerPool) only offer it events 
+         * that it could match. Listeners that never call this are offered 
+         * every event posted to their pool
+         * @param type The type of event handled
+         * @param matcher Returns true if the event is of that type
+         * @note Needs to be called before the listener is enabled
+         */
+        void setEventType(std::type_info const& type, EventMatcher matcher);
 
         virtual EventListenerPool* getPool() const;
         virtual ListenerResult handle(Event*) = 0;
@@ -153,6 +219,7 @@ namespace geode {
 
         EventListener(T filter = T()) : m_filter(filter) {
             m_filter.setListener(this);
+            this->setEventType(typeid(typename T::Event), &EventListener::matchesEvent);
             this->enable();
         }
 
@@ -160,11 +227,13 @@ namespace geode {
           : m_callback(fn), m_filter(filter)
         {
             m_filter.setListener(this);
+            this->setEventType(typeid(typename T::Event), &EventListener::matchesEvent);
             this->enable();
         }
 
         EventListener(Callback* fnptr, T filter = T()) : m_callback(fnptr), m_filter(filter) {
             m_filter.setListener(this);
+            this->setEventType(typeid(typename T::Event), &EventListener::matchesEvent);
             this->enable();
         }
 
@@ -182,6 +251,7 @@ namespace geode {
         {
             m_filter.setListener(this);
             other.disable();
+            this->setEventType(typeid(typename T::Event), &EventListener::matchesEvent);
             this->enable();
         }
 
@@ -190,6 +260,7 @@ namespace geode {
             m_filter(other.m_filter)
         {
             m_filter.setListener(this);
+            this->setEventType(typeid(typename T::Event), &EventListener::matchesEvent);
             this->enable();
         }
 
@@ -208,6 +279,7 @@ namespace geode {
         void setFilter(T filter) {
             m_filter = filter;
             m_filter.setListener(this);
+            this->updatePool();
         }
 
         T& getFilter() {
@@ -225,6 +297,10 @@ namespace geode {
     protected:
         utils::MiniFunction<Callback> m_callback = nullptr;
         T m_filter;
+
+        static bool matchesEvent(Event* e) {
+            return cast::typeinfo_cast<typename T::Event*>(e) != nullptr;
+        }
     };
 
     class GEODE_DLL [[nodiscard]] Event {
@@ -5,6 +5,7 @@
 #include <matjson.hpp>
 #include "Tulip.hpp"
 #include <cinttypes>
+#include <span>
 #include <string_view>
 #include <tulip/TulipHook.hpp>
 
@@ -176,6 +177,17 @@ namespace geode {
 
         Result<> disable();
 
+        /**
+         * Enable multiple patches at once. Either all of the patches are
+         * enabled, or none of them are if any overlaps another patch or
+         * fails to apply. Patches that directly follow each other are
+         * written together, which is faster than enabling them one by one.
+         * To use this for a mod's patches, turn off auto enable on them
+         * before claiming them with Mod::claimPatch
+         * @param patches The patches; ones that are already enabled are skipped
+         */
+        static Result<> enableAll(std::span<Patch* const> patches);
+
         /**
         * Get whether the patch should be auto enabled or not.
         * @returns Auto enable
@@ -71,6 +71,15 @@ namespace matjson {
     }
 }
 
+/**
+ * Logs below this severity are compiled out entirely, for example
+ * `GEODE_LOG_MIN_LEVEL=1` strips all debug logs. See the `STRIP_DEBUG_LOGS`
+ * option of `setup_geode_mod`
+ */
+#ifndef GEODE_LOG_MIN_LEVEL
+    #define GEODE_LOG_MIN_LEVEL 0
+#endif
+
 namespace geode {
 
     class Mod;
@@ -81,9 +90,16 @@ namespace geode {
         GEODE_DLL std::string generateLogName();
 
         GEODE_DLL void vlogImpl(Severity, Mod*, fmt::string_view format, fmt::format_args args);
+        /**
+         * Check whether a log would be logged, based on the mod's log level
+         * and whether it has logging enabled at all
+         */
+        GEODE_DLL bool isEnabled(Severity severity, Mod* mod);
 
         template <typename... Args>
         inline void logImpl(Severity severity, Mod* mod, impl::FmtStr<Args...> str, Args&&... args) {
+            // bail before the arguments are converted or anything is formatted
+            if (!isEnabled(severity, mod)) return;
             [&]<typename... Ts>(Ts&&... args) {
                 vlogImpl(severity, mod, str, fmt::make_format_args(args...));
             }(impl::wrapCocosObj(args)...);
@@ -91,22 +107,30 @@ namespace geode {
 
         template <typename... Args>
         inline void debug(impl::FmtStr<Args...> str, Args&&... args) {
-            logImpl(Severity::Debug, getMod(), str, std::forward<Args>(args)...);
+            if constexpr (GEODE_LOG_MIN_LEVEL <= Severity::Debug) {
+                logImpl(Severity::Debug, getMod(), str, std::forward<Args>(args)...);
+            }
         }
 
         template <typename... Args>
         inline void info(impl::FmtStr<Args...> str, Args&&... args) {
-            logImpl(Severity::Info, getMod(), str, std::forward<Args>(args)...);
+            if constexpr (GEODE_LOG_MIN_LEVEL <= Severity::Info) {
+                logImpl(Severity::Info, getMod(), str, std::forward<Args>(args)...);
+            }
         }
 
         template <typename... Args>
         inline void warn(impl::FmtStr<Args...> str, Args&&... args) {
-            logImpl(Severity::Warning, getMod(), str, std::forward<Args>(args)...);
+            if constexpr (GEODE_LOG_MIN_LEVEL <= Severity::Warning) {
+                logImpl(Severity::Warning, getMod(), str, std::forward<Args>(args)...);
+            }
         }
 
         template <typename... Args>
         inline void error(impl::FmtStr<Args...> str, Args&&... args) {
-            logImpl(Severity::Error, getMod(), str, std::forward<Args>(args)...);
+            if constexpr (GEODE_LOG_MIN_LEVEL <= Severity::Error) {
+                logImpl(Severity::Error, getMod(), str, std::forward<Args>(args)...);
+            }
         }
 
         GEODE_DLL void pushNest(Mod* mod);
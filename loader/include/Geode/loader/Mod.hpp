@@ -511,6 +511,12 @@ namespace geode {
 
         bool isLoggingEnabled() const;
         void setLoggingEnabled(bool enabled);
+        /**
+         * Get the lowest severity of logs from this mod that are logged;
+         * anything below it is dropped before being formatted
+         */
+        Severity getLogLevel() const;
+        void setLogLevel(Severity level);
 
         bool hasProblems() const;
         std::vector<LoadProblem> getAllProblems() const;
@@ -33,11 +33,11 @@ namespace geode::modifier {
         }
 
         void* getField(size_t index) {
-            while (m_containedFields.size() <= index) {
-                m_containedFields.push_back(nullptr);
-                m_destructorFunctions.push_back(nullptr);
+            if (m_containedFields.size() <= index) {
+                m_containedFields.resize(index + 1, nullptr);
+                m_destructorFunctions.resize(index + 1, nullptr);
             }
-            return m_containedFields.at(index);
+            return m_containedFields[index];
         }
 
         void* setField(size_t index, size_t size, utils::MiniFunction<void(void*)> destructor) {
@@ -52,6 +52,12 @@ namespace geode::modifier {
     };
 
     GEODE_DLL size_t getFieldIndexForClass(char const* name);
+    /**
+     * Get a number identifying a modified class, shared across all mods.
+     * Containers can then be looked up by it without hashing the name
+     */
+    GEODE_DLL size_t getFieldClassIndex(char const* name);
+    GEODE_DLL FieldContainer* getFieldContainer(cocos2d::CCNode* node, size_t classIndex);
 
     template <class Parent, class Base>
     class FieldIntermediate {
@@ -78,13 +84,14 @@ namespace geode::modifier {
             auto node = reinterpret_cast<Parent*>(reinterpret_cast<std::byte*>(this) - sizeof(Base));
             // static_assert(sizeof(Base) + sizeof() == sizeof(Intermediate), "offsetof not correct");
 
-            // generating the container if it doesn't exist
-            auto container = FieldContainer::from(node, typeid(Base).name());
-
-            // the index is global across all mods, so the
-            // function is defined in the loader source
+            // the indices are global across all mods, so the
+            // functions are defined in the loader source
+            static size_t classIndex = getFieldClassIndex(typeid(Base).name());
             static size_t index = getFieldIndexForClass(typeid(Base).name());
 
+            // generating the container if it doesn't exist
+            auto container = getFieldContainer(node, classIndex);
+
             // the fields are actually offset from their original
             // offset, this is done to save on allocation and space
             auto offsetField = container->getField(index);
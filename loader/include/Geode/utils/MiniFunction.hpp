@@ -3,6 +3,10 @@
 #include <Geode/DefaultInclude.hpp>
 #include <memory>
 #include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
 #include "terminate.hpp"
 
 namespace geode::utils {
@@ -23,7 +27,7 @@ namespace geode::utils {
     public:
         Type m_func;
 
-        explicit MiniFunctionState(Type func) : m_func(func) {}
+        explicit MiniFunctionState(Type func) : m_func(std::move(func)) {}
 
         Ret call(Args... args) const override {
             return const_cast<Type&>(m_func)(std::forward<Args>(args)...);
@@ -138,4 +142,160 @@ namespace geode::utils {
             return m_state;
         }
     };
+
+    template <class FunctionType>
+    class MoveOnlyFunction;
+
+    /**
+     * A move-only alternative to MiniFunction for owning callables that are
+     * only ever called from one place, like queued jobs. Small callables
+     * (captureless lambdas, function pointers, lambdas capturing a couple of
+     * pointers) are stored inline without any heap allocation, and since it
+     * can't be copied there is no clone() to go through either.
+     * Callables larger than INLINE_SIZE, or ones that may throw while being
+     * moved, are heap-allocated like with MiniFunction
+     */
+    template <class Ret, class... Args>
+    class MoveOnlyFunction<Ret(Args...)> {
+    public:
+        using FunctionType = Ret(Args...);
+
+        static constexpr size_t INLINE_SIZE = sizeof(void*) * 3;
+
+    private:
+        struct Operations {
+            Ret(*call)(void* storage, Args&&... args);
+            // Move-constructs the callable into `to` and destroys the one in `from`
+            void(*relocate)(void* from, void* to) noexcept;
+            void(*destroy)(void* storage) noexcept;
+        };
+
+        template <class Type>
+        static constexpr bool IS_INLINE =
+            sizeof(Type) <= INLINE_SIZE &&
+            alignof(Type) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<Type>;
+
+        template <class Type>
+        static Type* inlineObject(void* storage) {
+            return std::launder(static_cast<Type*>(storage));
+        }
+
+        template <class Type>
+        static Type* heapObject(void* storage) {
+            return *static_cast<Type**>(storage);
+        }
+
+        template <class Type>
+        static constexpr Operations INLINE_OPERATIONS = {
+            [](void* storage, Args&&... args) -> Ret {
+                return std::invoke(*inlineObject<Type>(storage), std::forward<Args>(args)...);
+            },
+            [](void* from, void* to) noexcept {
+                auto obj = inlineObject<Type>(from);
+                new (to) Type(std::move(*obj));
+                obj->~Type();
+            },
+            [](void* storage) noexcept {
+                inlineObject<Type>(storage)->~Type();
+            },
+        };
+
+        template <class Type>
+        static constexpr Operations HEAP_OPERATIONS = {
+            [](void* storage, Args&&... args) -> Ret {
+                return std::invoke(*heapObject<Type>(storage), std::forward<Args>(args)...);
+            },
+            [](void* from, void* to) noexcept {
+                new (to) Type*(heapObject<Type>(from));
+            },
+            [](void* storage) noexcept {
+                delete heapObject<Type>(storage);
+            },
+        };
+
+        alignas(std::max_align_t) mutable std::byte m_storage[INLINE_SIZE];
+        Operations const* m_operations = nullptr;
+
+        void reset() {
+            if (m_operations) {
+                m_operations->destroy(m_storage);
+                m_operations = nullptr;
+            }
+        }
+
+        void takeFrom(MoveOnlyFunction& other) {
+            if (other.m_operations) {
+                other.m_operations->relocate(other.m_storage, m_storage);
+                m_operations = other.m_operations;
+                other.m_operations = nullptr;
+            }
+        }
+
+    public:
+        MoveOnlyFunction() = default;
+
+        MoveOnlyFunction(std::nullptr_t) : MoveOnlyFunction() {}
+
+        MoveOnlyFunction(MoveOnlyFunction const&) = delete;
+
+        MoveOnlyFunction(MoveOnlyFunction&& other) noexcept {
+            this->takeFrom(other);
+        }
+
+        template <class Callable>
+        requires(
+            std::is_invocable_r_v<Ret, std::decay_t<Callable>&, Args...> &&
+            !std::is_same_v<std::decay_t<Callable>, MoveOnlyFunction<FunctionType>>
+        )
+        MoveOnlyFunction(Callable&& func) {
+            using Type = std::decay_t<Callable>;
+            // null function pointers make for an empty function, same as nullptr
+            using Passed = std::remove_cvref_t<Callable>;
+            if constexpr (std::is_pointer_v<Passed> || std::is_member_pointer_v<Passed>) {
+                if (!func) return;
+            }
+            if constexpr (IS_INLINE<Type>) {
+                new (m_storage) Type(std::forward<Callable>(func));
+                m_operations = &INLINE_OPERATIONS<Type>;
+            }
+            else {
+                new (m_storage) Type*(new Type(std::forward<Callable>(func)));
+                m_operations = &HEAP_OPERATIONS<Type>;
+            }
+        }
+
+        ~MoveOnlyFunction() {
+            this->reset();
+        }
+
+        MoveOnlyFunction& operator=(MoveOnlyFunction const&) = delete;
+
+        MoveOnlyFunction& operator=(MoveOnlyFunction&& other) noexcept {
+            if (this != &other) {
+                this->reset();
+                this->takeFrom(other);
+            }
+            return *this;
+        }
+
+        MoveOnlyFunction& operator=(std::nullptr_t) {
+            this->reset();
+            return *this;
+        }
+
+        Ret operator()(Args... args) const {
+            if (!m_operations) {
+                utils::terminate(
+                    "Attempted to call a MoveOnlyFunction that was never assigned "
+                    "any function, or one that has been moved"
+                );
+            }
+            return m_operations->call(m_storage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const {
+            return m_operations;
+        }
+    };
 }
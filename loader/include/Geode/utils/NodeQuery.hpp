@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Result.hpp"
+
+#include <Geode/DefaultInclude.hpp>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cocos2d {
+    class CCNode;
+}
+
+namespace geode {
+    /**
+     * A parsed `CCNode::querySelector` query. Parsing a query is much slower
+     * than running it, so queries that are run often should be compiled once
+     * and reused. The query syntax is:
+     *  - `node-id`: Match a node with a specific ID
+     *  - `*`: Match any node
+     *  - `:type(ClassName)`: Match a node whose class is exactly `ClassName`
+     *    (without namespaces), for example `:type(CCMenuItemSpriteExtra)`
+     *  - `:index(n)`: Match the `n`th child of its parent, starting from 0.
+     *    Negative indices count from the end, so `:index(-1)` is the last child
+     *  - `a b`: Match a node matching `b` that is a descendant (possibly not
+     *    immediate) child of a node matching `a`
+     *  - `a > b`: Match a node matching `b` that is an immediate child of a
+     *    node matching `a`
+     * IDs, types and indices can be combined, like `button-menu:index(0)` or
+     * `*:type(CCSprite):index(-1)`
+     * @note Matches are found in depth-first order, so the first match is the
+     * first one in the child tree as written out, not the least nested one
+     */
+    class GEODE_DLL NodeQuery final {
+    public:
+        class Impl;
+
+    private:
+        // shared since compiled queries never change
+        std::shared_ptr<Impl> m_impl;
+
+        NodeQuery(std::shared_ptr<Impl>&& impl);
+
+    public:
+        /**
+         * Parse a query
+         * @returns The compiled query, or an error describing what's wrong
+         * with the query
+         */
+        static Result<NodeQuery> compile(std::string_view query);
+
+        /**
+         * Find the first descendant of `root` matching this query
+         * @returns The node, or nullptr if none was found
+         */
+        cocos2d::CCNode* match(cocos2d::CCNode* root) const;
+        /**
+         * Find every descendant of `root` matching this query, in depth-first
+         * order
+         */
+        std::vector<cocos2d::CCNode*> matchAll(cocos2d::CCNode* root) const;
+
+        std::string toString() const;
+    };
+}
@@ -4,10 +4,59 @@
 #include "MiniFunction.hpp"
 #include "../loader/Event.hpp"
 #include "../loader/Loader.hpp"
+#include <chrono>
 #include <mutex>
 #include <string_view>
 
 namespace geode {
+    struct TaskExecutorStats final {
+        /// Number of threads currently running
+        size_t threadCount = 0;
+        /// Number of threads currently waiting for work
+        size_t idleThreadCount = 0;
+        /// Number of jobs waiting for a thread
+        size_t queuedCount = 0;
+        /// Number of jobs that have been started so far
+        size_t startedCount = 0;
+        /// Number of jobs that were given a thread of their own because 
+        /// every worker was busy
+        size_t spilledCount = 0;
+        /// Average time jobs spent waiting before being started
+        std::chrono::microseconds averageQueueLatency = std::chrono::microseconds(0);
+        /// Longest time a job has spent waiting before being started
+        std::chrono::microseconds maxQueueLatency = std::chrono::microseconds(0);
+    };
+
+    /**
+     * Runs the bodies of Tasks. By default Tasks run on the shared executor, 
+     * which reuses a bounded set of worker threads. When all of them are 
+     * busy, Tasks get a thread of their own like they used to, so a Task 
+     * that blocks for a long time never holds up others. Use `Task::runOn` 
+     * with `TaskExecutor::getDedicated()` to always get a new thread
+     */
+    class GEODE_DLL TaskExecutor {
+    public:
+        using Job = utils::MoveOnlyFunction<void()>;
+
+        /**
+         * Run a job at some point on some thread
+         * @param job The job to run
+         * @param name The name of the Task the job is for; used for debugging
+         */
+        virtual void post(Job&& job, std::string_view const name) = 0;
+        virtual TaskExecutorStats getStats() const = 0;
+        virtual ~TaskExecutor();
+
+        /**
+         * The executor Tasks run on by default
+         */
+        static TaskExecutor* getShared();
+        /**
+         * An executor that creates a new thread for every job
+         */
+        static TaskExecutor* getDedicated();
+    };
+
     /**
      * Tasks represent an asynchronous operation that will be finished at some 
      * unknown point in the future. Tasks can report their progress, and will 
@@ -203,6 +252,11 @@ namespace geode {
             template <std::move_constructible T2, std::move_constructible P2>
             friend class Task;
 
+        protected:
+            EventListenerPool* getPool() const override {
+                return KeyedEventListenerPool::getForPosting(m_handle);
+            }
+
         public:
             /**
              * Get a reference to the contained finish value, or null if this 
@@ -418,9 +472,19 @@ namespace geode {
          * @param name The name of the Task; used for debugging
          */
         static Task run(Run&& body, std::string_view const name = "<Task>") {
+            return Task::runOn(TaskExecutor::getShared(), std::move(body), name);
+        }
+        /**
+         * Create a new Task with a function that returns the finished value, 
+         * and run it on a specific executor
+         * @param executor The executor to run the body on
+         * @param body The body aka actual code of the Task. Note that this 
+         * function MUST be synchronous - the executor provides the thread!
+         * @param name The name of the Task; used for debugging
+         */
+        static Task runOn(TaskExecutor* executor, Run&& body, std::string_view const name = "<Task>") {
             auto task = Task(Handle::create(name));
-            std::thread([handle = std::weak_ptr(task.m_handle), name = std::string(name), body = std::move(body)] {
-                utils::thread::setName(fmt::format("Task '{}'", name));
+            executor->post([handle = std::weak_ptr(task.m_handle), body = std::move(body)] {
                 auto result = body(
                     [handle](P progress) {
                         Task::progress(handle.lock(), std::move(progress));
@@ -438,7 +502,7 @@ namespace geode {
                 else {
                     Task::finish(handle.lock(), std::move(*std::move(result).getValue()));
                 }
-            }).detach();
+            }, name);
             return task;
         }
         /**
@@ -451,9 +515,20 @@ namespace geode {
          * @param name The name of the Task; used for debugging
          */
         static Task runWithCallback(RunWithCallback&& body, std::string_view const name = "<Callback Task>") {
+            return Task::runWithCallbackOn(TaskExecutor::getShared(), std::move(body), name);
+        }
+        /**
+         * Create a Task using a body that may need to create additional 
+         * threads within itself, and run it on a specific executor
+         * @param executor The executor to run the body on
+         * @param body The body aka actual code of the Task. The body may 
+         * call its provided finish callback *exactly once* - subsequent 
+         * calls will always be ignored
+         * @param name The name of the Task; used for debugging
+         */
+        static Task runWithCallbackOn(TaskExecutor* executor, RunWithCallback&& body, std::string_view const name = "<Callback Task>") {
             auto task = Task(Handle::create(name));
-            std::thread([handle = std::weak_ptr(task.m_handle), name = std::string(name), body = std::move(body)] {
-                utils::thread::setName(fmt::format("Task '{}'", name));
+            executor->post([handle = std::weak_ptr(task.m_handle), body = std::move(body)] {
                 body(
                     [handle](Result result) {
                         if (result.isCancelled()) {
@@ -473,7 +548,7 @@ namespace geode {
                         return !lock || lock->is(Status::Cancelled);
                     }
                 );
-            }).detach();
+            }, name);
             return task;
         }
         /**
@@ -759,9 +834,13 @@ namespace geode {
             return ListenerResult::Propagate;
         }
 
-        // todo: i believe alk wanted tasks to be in their own pool
+        // Every Task gets a pool of its own, so finishing a Task only goes 
+        // through the listeners for that Task
         EventListenerPool* getPool() const {
-            return DefaultEventListenerPool::get();
+            if (!m_handle) {
+                return DefaultEventListenerPool::get();
+            }
+            return KeyedEventListenerPool::get(m_handle);
         }
 
         void setListener(EventListenerProtocol* listener) {
@@ -8,6 +8,7 @@
 #include <matjson.hpp>
 #include <Geode/DefaultInclude.hpp>
 #include <filesystem>
+#include <span>
 #include <string>
 #include <unordered_set>
 
@@ -53,6 +54,43 @@ namespace geode::utils::file {
         std::filesystem::path const& path, bool recursive = false
     );
 
+    /**
+     * A read-only view of a file's contents mapped into memory, so it can 
+     * be read without copying it into a buffer first
+     */
+    class GEODE_DLL MappedFile final {
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_impl;
+
+        MappedFile(std::unique_ptr<Impl>&& impl);
+
+    public:
+        MappedFile(MappedFile const&) = delete;
+        MappedFile(MappedFile&& other);
+        ~MappedFile();
+
+        using Path = std::filesystem::path;
+
+        /**
+         * Map a file into memory. The file can still be renamed or deleted 
+         * while it's mapped, but it must not be modified
+         * @warning On platforms other than Windows, reading a mapped file 
+         * that has been truncated crashes the game with SIGBUS, so only map 
+         * files that are replaced by moving a new file over them (like mods 
+         * are when updating) and don't keep the mapping around for longer 
+         * than needed
+         */
+        static Result<MappedFile> create(Path const& path);
+
+        /**
+         * The contents of the file; valid for as long as this MappedFile is
+         */
+        std::span<const uint8_t> data() const;
+        size_t size() const;
+        Path getPath() const;
+    };
+
     class Unzip;
 
     class GEODE_DLL Zip final {
@@ -187,6 +225,24 @@ namespace geode::utils::file {
          * @param name Entry path in zip
          */
         Result<ByteVector> extract(Path const& name);
+        /**
+         * Extract multiple entries to memory. The entries are read in the 
+         * order they're stored in the zip, which is faster than calling 
+         * `extract` for each of them
+         * @param names Entry paths in zip
+         * @returns The data of each entry, in the same order as `names`
+         */
+        Result<std::vector<ByteVector>> extractMany(std::vector<Path> const& names);
+        /**
+         * Get an entry's data without copying or decompressing it. This 
+         * only works for entries stored without compression in zips opened 
+         * from a file; for others, an error is returned and `extract` 
+         * should be used instead
+         * @param name Entry path in zip
+         * @returns A view of the entry's data, valid for as long as this 
+         * Unzip is
+         */
+        Result<std::span<const uint8_t>> extractView(Path const& name);
         /**
          * Extract entry to file
          * @param name Entry path in zip
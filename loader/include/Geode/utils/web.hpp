@@ -6,9 +6,17 @@
 #include "Task.hpp"
 #include <chrono>
 #include <optional>
+#include <span>
 
 namespace geode::utils::web {
     GEODE_DLL void openLinkInBrowser(std::string const& url);
+
+    /**
+     * Remove the response kept on disk for `url` by requests made with
+     * `WebRequest::diskCache`, so the next request for it is sent without
+     * conditional headers
+     */
+    GEODE_DLL void removeFromDiskCache(std::string const& url);
     
     // https://curl.se/libcurl/c/CURLOPT_HTTPAUTH.html
     namespace http_auth {
@@ -79,6 +87,11 @@ namespace geode::utils::web {
         Result<std::string> string() const;
         Result<matjson::Value> json() const;
         ByteVector data() const;
+        /**
+         * Get the body without copying it. The span is valid for as long 
+         * as this response (or a copy of it) is alive
+         */
+        std::span<const uint8_t> dataView() const;
         Result<> into(std::filesystem::path const& path) const;
 
         std::vector<std::string> headers() const;
@@ -203,6 +216,20 @@ namespace geode::utils::web {
          */
         WebRequest& followRedirects(bool enabled);
 
+        /**
+         * Keep the response to this GET request on disk if it has an ETag or 
+         * Last-Modified header. Later requests to the same URL with this 
+         * enabled are sent as conditional requests, and if the server 
+         * responds with 304 Not Modified, the response is given the cached 
+         * body and a 200 code, so it can be used just like a fresh one. 
+         * Ignored for requests using `intoFile`, `onChunk` or `downloadRange`.
+         * The default is false.
+         *
+         * @param enabled
+         * @return WebRequest&
+         */
+        WebRequest& diskCache(bool enabled);
+
         /**
          * Sets the Certificate Authority (CA) bundle content.
          * Defaults to not sending a CA bundle.
@@ -212,6 +239,30 @@ namespace geode::utils::web {
          */
         WebRequest& CABundleContent(std::string_view content);
 
+        /**
+         * Writes the response body into a file while it's being downloaded, 
+         * instead of keeping it in memory. The file is only written for 
+         * successful (2xx) responses, and removed again if the request 
+         * fails partway through. The body of responses streamed into a file 
+         * is not available through `WebResponse::data()`
+         *
+         * @param path
+         * @return WebRequest&
+         */
+        WebRequest& intoFile(std::filesystem::path const& path);
+
+        /**
+         * Calls a function with each piece of the response body as it's 
+         * downloaded, for example to hash or parse it incrementally. Like 
+         * with `intoFile`, this is only done for successful (2xx) responses, 
+         * whose body is then not kept in memory. The function is called 
+         * on a background thread
+         *
+         * @param onChunk
+         * @return WebRequest&
+         */
+        WebRequest& onChunk(utils::MiniFunction<void(std::span<const uint8_t>)> onChunk);
+
         /**
          * Sets the request's proxy.
          * Defaults to not using a proxy.
@@ -2,8 +2,11 @@
 #include <Geode/utils/cocos.hpp>
 #include <Geode/modify/Field.hpp>
 #include <Geode/modify/CCNode.hpp>
+#include <Geode/utils/NodeQuery.hpp>
 #include <cocos2d.h>
-#include <queue>
+#include <mutex>
+#include <string_view>
+#include <typeindex>
 
 using namespace geode::prelude;
 using namespace geode::modifier;
@@ -13,12 +16,69 @@ using namespace geode::modifier;
 
 constexpr auto METADATA_TAG = 0xB324ABC;
 
+// children are only indexed by ID once there's enough of them that a linear
+// search (which is just pointer comparisons) gets slow
+constexpr size_t MIN_CHILDREN_FOR_ID_INDEX = 16;
+
+namespace {
+    struct NodeIDHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view id) const {
+            return std::hash<std::string_view>()(id);
+        }
+    };
+
+    // every ID ever set on a node, so that nodes can just store a pointer to
+    // their ID and comparing IDs is comparing pointers
+    std::mutex s_nodeIDsMutex;
+    std::unordered_set<std::string, NodeIDHash, std::equal_to<>>& nodeIDs() {
+        static std::unordered_set<std::string, NodeIDHash, std::equal_to<>> ids;
+        return ids;
+    }
+
+    std::string const* internNodeID(std::string_view id) {
+        if (id.empty()) {
+            return nullptr;
+        }
+        std::unique_lock lock(s_nodeIDsMutex);
+        auto it = nodeIDs().find(id);
+        if (it == nodeIDs().end()) {
+            it = nodeIDs().emplace(id).first;
+        }
+        return &*it;
+    }
+
+    // returns null if no node has ever had this ID
+    std::string const* findNodeID(std::string_view id) {
+        if (id.empty()) {
+            return nullptr;
+        }
+        std::unique_lock lock(s_nodeIDsMutex);
+        auto it = nodeIDs().find(id);
+        return it != nodeIDs().end() ? &*it : nullptr;
+    }
+}
+
 struct ProxyCCNode;
 
 class GeodeNodeMetadata final : public cocos2d::CCObject {
 private:
-    std::unordered_map<std::string, FieldContainer*> m_classFieldContainers;
-    std::string m_id = "";
+    // indexed by getFieldClassIndex
+    std::vector<FieldContainer*> m_classFieldContainers;
+    // interned through internNodeID
+    std::string const* m_id = nullptr;
+    struct IndexedChild final {
+        CCNode* node;
+        // where the child was in the children array, so the entry can be
+        // checked without touching a child that might have been freed
+        unsigned int position;
+    };
+    // built when a child is looked up by ID, and cleared whenever children
+    // are added or removed or one of their IDs changes
+    std::optional<std::unordered_map<std::string const*, IndexedChild>> m_childrenByID;
+    // if several children share an ID, which one comes first depends on
+    // their order, which the index doesn't keep track of
+    bool m_duplicateChildIDs = false;
     Ref<Layout> m_layout = nullptr;
     Ref<LayoutOptions> m_layoutOptions = nullptr;
     std::unordered_map<std::string, Ref<CCObject>> m_userObjects;
@@ -31,21 +91,34 @@ private:
     GeodeNodeMetadata() {}
 
     virtual ~GeodeNodeMetadata() {
-        for (auto& [_, container] : m_classFieldContainers) {
+        for (auto container : m_classFieldContainers) {
             delete container;
         }
     }
 
 public:
-    static GeodeNodeMetadata* set(CCNode* target) {
+    /**
+     * Get the metadata of a node without creating it if it has none
+     */
+    static GeodeNodeMetadata* get(CCNode* target) {
         if (!target) return nullptr;
 
-        auto old = target->m_pUserObject;
+        auto obj = target->m_pUserObject;
         // faster than dynamic_cast, technically can
         // but extremely unlikely to fail
-        if (old && old->getTag() == METADATA_TAG) {
-            return static_cast<GeodeNodeMetadata*>(old);
+        if (obj && obj->getTag() == METADATA_TAG) {
+            return static_cast<GeodeNodeMetadata*>(obj);
+        }
+        return nullptr;
+    }
+
+    static GeodeNodeMetadata* set(CCNode* target) {
+        if (!target) return nullptr;
+
+        if (auto meta = GeodeNodeMetadata::get(target)) {
+            return meta;
         }
+        auto old = target->m_pUserObject;
         auto meta = new GeodeNodeMetadata();
         meta->autorelease();
         meta->setTag(METADATA_TAG);
@@ -66,11 +139,78 @@ public:
         return nullptr;
     }
 
-    FieldContainer* getFieldContainer(char const* forClass) {
-        if (!m_classFieldContainers.count(forClass)) {
-            m_classFieldContainers[forClass] = new FieldContainer();
+    static std::string const* getIDAtom(CCNode* node) {
+        auto meta = GeodeNodeMetadata::get(node);
+        return meta ? meta->m_id : nullptr;
+    }
+
+    static void invalidateChildrenByID(CCNode* parent) {
+        if (auto meta = GeodeNodeMetadata::get(parent)) {
+            meta->m_childrenByID.reset();
         }
-        return m_classFieldContainers[forClass];
+    }
+
+    void indexChildren(CCArray* children) {
+        auto& index = m_childrenByID.emplace();
+        index.reserve(children->count());
+        m_duplicateChildIDs = false;
+        for (unsigned int i = 0; i < children->count(); i += 1) {
+            auto child = static_cast<CCNode*>(children->objectAtIndex(i));
+            if (auto childID = GeodeNodeMetadata::getIDAtom(child)) {
+                if (!index.try_emplace(childID, IndexedChild { child, i }).second) {
+                    m_duplicateChildIDs = true;
+                }
+            }
+        }
+    }
+
+    // nullopt if the index is out of date
+    std::optional<CCNode*> findIndexedChild(CCArray* children, std::string const* id) {
+        auto it = m_childrenByID->find(id);
+        if (it == m_childrenByID->end()) {
+            return nullptr;
+        }
+        auto [child, position] = it->second;
+        if (position >= children->count() || children->objectAtIndex(position) != child) {
+            return std::nullopt;
+        }
+        // the child is still in the array, so it's safe to look at
+        if (GeodeNodeMetadata::getIDAtom(child) != id) {
+            return std::nullopt;
+        }
+        return child;
+    }
+
+    // nullopt if the children have to be searched instead
+    std::optional<CCNode*> getChildByID(CCArray* children, std::string const* id) {
+        if (!m_childrenByID) {
+            this->indexChildren(children);
+        }
+        if (m_duplicateChildIDs) {
+            return std::nullopt;
+        }
+        auto child = this->findIndexedChild(children, id);
+        // in case the children were changed in some way that isn't hooked,
+        // or were reordered
+        if (!child) {
+            this->indexChildren(children);
+            if (m_duplicateChildIDs) {
+                return std::nullopt;
+            }
+            child = this->findIndexedChild(children, id);
+        }
+        return child.value_or(nullptr);
+    }
+
+    FieldContainer* getFieldContainer(size_t classIndex) {
+        if (m_classFieldContainers.size() <= classIndex) {
+            m_classFieldContainers.resize(classIndex + 1, nullptr);
+        }
+        auto& container = m_classFieldContainers[classIndex];
+        if (!container) {
+            container = new FieldContainer();
+        }
+        return container;
     }
 };
 
@@ -97,6 +237,20 @@ struct ProxyCCNode : Modify<ProxyCCNode, CCNode> {
             CC_SAFE_RETAIN(m_pUserObject);
         }
     }
+
+    // keep the children-by-ID index in sync
+    void addChild(CCNode* child, int zOrder, int tag) {
+        CCNode::addChild(child, zOrder, tag);
+        GeodeNodeMetadata::invalidateChildrenByID(this);
+    }
+    void removeChild(CCNode* child, bool cleanup) {
+        CCNode::removeChild(child, cleanup);
+        GeodeNodeMetadata::invalidateChildrenByID(this);
+    }
+    void removeAllChildrenWithCleanup(bool cleanup) {
+        CCNode::removeAllChildrenWithCleanup(cleanup);
+        GeodeNodeMetadata::invalidateChildrenByID(this);
+    }
 };
 
 static inline std::unordered_map<std::string, size_t> s_nextIndex;
@@ -104,198 +258,420 @@ size_t modifier::getFieldIndexForClass(char const* name) {
 	return s_nextIndex[name]++;
 }
 
+static inline std::unordered_map<std::string, size_t> s_classIndices;
+size_t modifier::getFieldClassIndex(char const* name) {
+    return s_classIndices.try_emplace(name, s_classIndices.size()).first->second;
+}
+
+FieldContainer* modifier::getFieldContainer(CCNode* node, size_t classIndex) {
+    return GeodeNodeMetadata::set(node)->getFieldContainer(classIndex);
+}
+
 // not const because might modify contents
 FieldContainer* CCNode::getFieldContainer() {
     return GeodeNodeMetadata::set(this)->getFieldContainer();
 }
 
 FieldContainer* CCNode::getFieldContainer(char const* forClass) {
-    return GeodeNodeMetadata::set(this)->getFieldContainer(forClass);
+    // mods built before getFieldClassIndex existed still come through here
+    return GeodeNodeMetadata::set(this)->getFieldContainer(getFieldClassIndex(forClass));
 }
 
 std::string CCNode::getID() {
-    return GeodeNodeMetadata::set(this)->m_id;
+    return std::string(this->getIDView());
 }
 
-void CCNode::setID(std::string const& id) {
-    GeodeNodeMetadata::set(this)->m_id = id;
+std::string_view CCNode::getIDView() {
+    auto id = GeodeNodeMetadata::getIDAtom(this);
+    return id ? std::string_view(*id) : std::string_view();
 }
 
-CCNode* CCNode::getChildByID(std::string const& id) {
-    for (auto child : CCArrayExt<CCNode*>(this->getChildren())) {
-        if (child->getID() == id) {
-            return child;
-        }
+void CCNode::setID(std::string const& id) {
+    auto atom = internNodeID(id);
+    // nodes without metadata have no ID, so there's nothing to clear
+    if (!atom && !GeodeNodeMetadata::get(this)) {
+        return;
     }
-    return nullptr;
+    GeodeNodeMetadata::set(this)->m_id = atom;
+    GeodeNodeMetadata::invalidateChildrenByID(m_pParent);
 }
 
-CCNode* CCNode::getChildByIDRecursive(std::string const& id) {
-    if (auto child = this->getChildByID(id)) {
-        return child;
+namespace {
+    CCNode* getChildByIDAtom(CCNode* node, std::string const* atom) {
+        auto children = node->getChildren();
+        if (!children || !children->count()) {
+            return nullptr;
+        }
+        // only nodes that already have metadata are indexed, so that looking 
+        // up children doesn't give every parent metadata
+        if (children->count() >= MIN_CHILDREN_FOR_ID_INDEX) {
+            if (auto meta = GeodeNodeMetadata::get(node)) {
+                if (auto child = meta->getChildByID(children, atom)) {
+                    return *child;
+                }
+            }
+        }
+        for (auto child : CCArrayExt<CCNode*>(children)) {
+            if (GeodeNodeMetadata::getIDAtom(child) == atom) {
+                return child;
+            }
+        }
+        return nullptr;
     }
-    for (auto child : CCArrayExt<CCNode*>(m_pChildren)) {
-        if ((child = child->getChildByIDRecursive(id))) {
+
+    CCNode* getChildByIDAtomRecursive(CCNode* node, std::string const* atom) {
+        if (auto child = getChildByIDAtom(node, atom)) {
             return child;
         }
+        for (auto child : CCArrayExt<CCNode*>(node->getChildren())) {
+            if ((child = getChildByIDAtomRecursive(child, atom))) {
+                return child;
+            }
+        }
+        return nullptr;
     }
-    return nullptr;
 }
 
-class BFSNodeTreeCrawler final {
-private:
-    std::queue<CCNode*> m_queue;
-    std::unordered_set<CCNode*> m_explored;
+CCNode* CCNode::getChildByID(std::string const& id) {
+    // if no node has ever had this ID, no child can have it either
+    auto atom = findNodeID(id);
+    return atom ? getChildByIDAtom(this, atom) : nullptr;
+}
 
-public:
-    BFSNodeTreeCrawler(CCNode* target) {
-        if (auto first = getChild(target, 0)) {
-            m_explored.insert(first);
-            m_queue.push(first);
+CCNode* CCNode::getChildByIDRecursive(std::string const& id) {
+    auto atom = findNodeID(id);
+    return atom ? getChildByIDAtomRecursive(this, atom) : nullptr;
+}
+
+namespace {
+    // the class name of a node without namespaces, like "CCMenu"
+    std::string_view getUnqualifiedTypeName(CCNode* node) {
+        static std::unordered_map<std::type_index, std::string> s_names;
+        auto& name = s_names[std::type_index(typeid(*node))];
+        if (name.empty()) {
+            std::string_view raw = typeid(*node).name();
+#ifdef GEODE_IS_WINDOWS
+            // "class cocos2d::CCMenu"
+            if (auto pos = raw.rfind("::"); pos != std::string_view::npos) {
+                raw.remove_prefix(pos + 2);
+            }
+            else if (auto pos = raw.find(' '); pos != std::string_view::npos) {
+                raw.remove_prefix(pos + 1);
+            }
+            name = raw;
+#else
+            // Itanium mangled, "6CCMenu" or "N7cocos2d6CCMenuE"
+            size_t i = raw.starts_with('N') ? 1 : 0;
+            while (i < raw.size() && std::isdigit(raw[i])) {
+                size_t length = 0;
+                while (i < raw.size() && std::isdigit(raw[i])) {
+                    length = length * 10 + (raw[i] - '0');
+                    i += 1;
+                }
+                name = raw.substr(i, length);
+                i += length;
+            }
+            if (name.empty()) {
+                name = raw;
+            }
+#endif
         }
+        return name;
     }
 
-    CCNode* next() {
-        if (m_queue.empty()) {
-            return nullptr;
+    // depth-first, without allocating anything; stops when `fn` returns true
+    template <class F>
+    bool forEachDescendant(CCNode* node, F&& fn) {
+        auto children = node->getChildren();
+        if (!children) {
+            return false;
         }
-        auto node = m_queue.front();
-        m_queue.pop();
-        for (auto sibling : CCArrayExt<CCNode*>(node->getParent()->getChildren())) {
-            if (!m_explored.contains(sibling)) {
-                m_explored.insert(sibling);
-                m_queue.push(sibling);
+        for (auto child : CCArrayExt<CCNode*>(children)) {
+            if (fn(child) || forEachDescendant(child, fn)) {
+                return true;
             }
         }
-        for (auto child : CCArrayExt<CCNode*>(node->getChildren())) {
-            if (!m_explored.contains(child)) {
-                m_explored.insert(child);
-                m_queue.push(child);
-            }
-        }
-        return node;
+        return false;
     }
-};
+}
 
-class NodeQuery final {
-private:
+class NodeQuery::Impl final {
+public:
     enum class Op {
         ImmediateChild,
         DescendantChild,
     };
 
-    std::string m_targetID;
-    Op m_nextOp;
-    std::unique_ptr<NodeQuery> m_next = nullptr;
+    struct Selector {
+        // empty matches any ID
+        std::string id;
+        std::string const* idAtom = nullptr;
+        // empty matches any type
+        std::string type;
+        std::optional<int> index;
+        // how this relates to the node matched by the previous selector (or
+        // the root, for the first one)
+        Op op = Op::DescendantChild;
+
+        bool matches(CCNode* node) const {
+            if (idAtom && GeodeNodeMetadata::getIDAtom(node) != idAtom) {
+                return false;
+            }
+            if (!type.empty() && getUnqualifiedTypeName(node) != type) {
+                return false;
+            }
+            if (index) {
+                auto parent = node->getParent();
+                if (!parent || !parent->getChildren()) {
+                    return false;
+                }
+                auto count = static_cast<int>(parent->getChildrenCount());
+                auto target = *index < 0 ? count + *index : *index;
+                if (target < 0 || target >= count || parent->getChildren()->objectAtIndex(target) != node) {
+                    return false;
+                }
+            }
+            return true;
+        }
 
-public:
-    static Result<std::unique_ptr<NodeQuery>> parse(std::string const& query) {
-        if (query.empty()) {
-            return Err("Query may not be empty");
+        std::string toString() const {
+            std::string str = id.empty() && type.empty() && !index ? "*" : id;
+            if (!type.empty()) {
+                str += fmt::format(":type({})", type);
+            }
+            if (index) {
+                str += fmt::format(":index({})", *index);
+            }
+            return str;
         }
+    };
+
+    std::vector<Selector> m_selectors;
 
-        auto result = std::make_unique<NodeQuery>();
-        NodeQuery* current = result.get();
+    static Result<std::shared_ptr<Impl>> parse(std::string_view query) {
+        auto result = std::make_shared<Impl>();
 
         size_t i = 0;
-        std::string collectedID;
-        std::optional<Op> nextOp = Op::DescendantChild;
-        while (i < query.size()) {
-            auto c = query.at(i);
-            if (c == ' ') {
-                if (!nextOp) {
-                    nextOp.emplace(Op::DescendantChild);
-                }
+        auto skipSpaces = [&] {
+            bool skipped = false;
+            while (i < query.size() && query[i] == ' ') {
+                i += 1;
+                skipped = true;
+            }
+            return skipped;
+        };
+        auto isIDChar = [](char c) {
+            return std::isalnum(c) || c == '-' || c == '_' || c == '/' || c == '.';
+        };
+        auto readWhile = [&](auto pred) {
+            auto start = i;
+            while (i < query.size() && pred(query[i])) {
+                i += 1;
+            }
+            return query.substr(start, i - start);
+        };
+
+        skipSpaces();
+        if (i >= query.size()) {
+            return Err("Query may not be empty");
+        }
+        // a leading > matches immediate children of the node being queried
+        auto op = Op::DescendantChild;
+        if (query[i] == '>') {
+            op = Op::ImmediateChild;
+            i += 1;
+            skipSpaces();
+        }
+        while (true) {
+            Selector selector;
+            selector.op = op;
+
+            auto start = i;
+            if (i < query.size() && query[i] == '*') {
+                i += 1;
             }
-            else if (c == '>') {
-                if (!nextOp || *nextOp == Op::DescendantChild) {
-                    nextOp.emplace(Op::ImmediateChild);
+            else {
+                selector.id = readWhile(isIDChar);
+                selector.idAtom = internNodeID(selector.id);
+            }
+            while (i < query.size() && query[i] == ':') {
+                i += 1;
+                auto name = readWhile([](char c) { return std::isalpha(c) || c == '-'; });
+                if (i >= query.size() || query[i] != '(') {
+                    return Err("Expected '(' after ':{}' (index {})", name, i);
+                }
+                i += 1;
+                auto arg = readWhile([](char c) { return c != ')'; });
+                if (i >= query.size()) {
+                    return Err("Expected ')' but got end of query");
+                }
+                i += 1;
+                if (name == "type") {
+                    if (arg.empty()) {
+                        return Err("Expected type name in ':type()' (index {})", i);
+                    }
+                    selector.type = arg;
+                }
+                else if (name == "index") {
+                    auto index = numFromString<int>(arg);
+                    if (!index) {
+                        return Err("Invalid index '{}' (index {})", arg, i);
+                    }
+                    selector.index = index.unwrap();
                 }
-                // Double >> is syntax error
                 else {
-                    return Err("Can't have multiple child operators at once (index {})", i);
+                    return Err("Unknown selector ':{}' (index {})", name, start);
                 }
             }
-            // ID-valid characters
-            else if (std::isalnum(c) || c == '-' || c == '_' || c == '/' || c == '.') {
-                if (nextOp) {
-                    current->m_next = std::make_unique<NodeQuery>();
-                    current->m_nextOp = *nextOp;
-                    current->m_targetID = collectedID;
-                    current = current->m_next.get();
-
-                    collectedID = "";
-                    nextOp = std::nullopt;
+            if (i == start) {
+                if (i >= query.size()) {
+                    return Err("Expected node ID but got end of query");
+                }
+                // Any other character is syntax error due to needing to reserve 
+                // stuff for possible future features
+                return Err("Unexpected character '{}' at index {}", query[i], i);
+            }
+            result->m_selectors.push_back(std::move(selector));
+
+            auto hadSpace = skipSpaces();
+            if (i >= query.size()) {
+                break;
+            }
+            if (query[i] == '>') {
+                i += 1;
+                skipSpaces();
+                if (i < query.size() && query[i] == '>') {
+                    // Double >> is syntax error
+                    return Err("Can't have multiple child operators at once (index {})", i);
                 }
-                collectedID.push_back(c);
+                op = Op::ImmediateChild;
+            }
+            else if (hadSpace) {
+                op = Op::DescendantChild;
             }
-            // Any other character is syntax error due to needing to reserve 
-            // stuff for possible future features
             else {
-                return Err("Unexpected character '{}' at index {}", c, i);
+                return Err("Unexpected character '{}' at index {}", query[i], i);
+            }
+            if (i >= query.size()) {
+                return Err("Expected node ID but got end of query");
             }
-            i += 1;
-        }
-        if (nextOp || collectedID.empty()) {
-            return Err("Expected node ID but got end of query");
         }
-        current->m_targetID = collectedID;
 
-        return Ok(std::move(result));
+        return Ok(result);
     }
 
-    CCNode* match(CCNode* node) const {
-        // Make sure this matches the ID being looked for
-        if (!m_targetID.empty() && node->getID() != m_targetID) {
-            return nullptr;
+    // matches from the last selector backwards, going up the parents
+    bool matches(CCNode* root, CCNode* node, size_t selectorIndex) const {
+        auto& selector = m_selectors[selectorIndex];
+        if (!selector.matches(node)) {
+            return false;
         }
-        // If this is the last thing to match, return the result
-        if (!m_next) {
-            return node;
+        auto parent = node->getParent();
+        if (selectorIndex == 0) {
+            // every node passed in is already a descendant of the root
+            return selector.op == Op::DescendantChild || parent == root;
         }
-        switch (m_nextOp) {
+        switch (selector.op) {
             case Op::ImmediateChild: {
-                for (auto c : CCArrayExt<CCNode*>(node->getChildren())) {
-                    if (auto r = m_next->match(c)) {
-                        return r;
-                    }
-                }
-            } break;
-
+                return parent && parent != root && this->matches(root, parent, selectorIndex - 1);
+            }
             case Op::DescendantChild: {
-                auto crawler = BFSNodeTreeCrawler(node);
-                while (auto c = crawler.next()) {
-                    if (auto r = m_next->match(c)) {
-                        return r;
+                for (; parent && parent != root; parent = parent->getParent()) {
+                    if (this->matches(root, parent, selectorIndex - 1)) {
+                        return true;
                     }
                 }
-            } break;
+                return false;
+            }
         }
-        return nullptr;
+        return false;
     }
 
-    std::string toString() const {
-        auto str = m_targetID.empty() ? "&" : m_targetID;
-        if (m_next) {
-            switch (m_nextOp) {
-                case Op::ImmediateChild: str += " > "; break;
-                case Op::DescendantChild: str += " "; break;
-            }
-            str += m_next->toString();
-        }
-        return str;
+    bool matches(CCNode* root, CCNode* node) const {
+        return this->matches(root, node, m_selectors.size() - 1);
     }
 };
 
-CCNode* CCNode::querySelector(std::string const& queryStr) {
-    auto res = NodeQuery::parse(queryStr);
+NodeQuery::NodeQuery(std::shared_ptr<Impl>&& impl) : m_impl(std::move(impl)) {}
+
+Result<NodeQuery> NodeQuery::compile(std::string_view query) {
+    GEODE_UNWRAP_INTO(auto impl, Impl::parse(query));
+    return Ok(NodeQuery(std::move(impl)));
+}
+
+CCNode* NodeQuery::match(CCNode* root) const {
+    CCNode* result = nullptr;
+    forEachDescendant(root, [&](CCNode* node) {
+        if (m_impl->matches(root, node)) {
+            result = node;
+            return true;
+        }
+        return false;
+    });
+    return result;
+}
+
+std::vector<CCNode*> NodeQuery::matchAll(CCNode* root) const {
+    std::vector<CCNode*> result;
+    forEachDescendant(root, [&](CCNode* node) {
+        if (m_impl->matches(root, node)) {
+            result.push_back(node);
+        }
+        return false;
+    });
+    return result;
+}
+
+std::string NodeQuery::toString() const {
+    std::string str;
+    for (auto& selector : m_impl->m_selectors) {
+        if (selector.op == Impl::Op::ImmediateChild) {
+            str += str.empty() ? "> " : " > ";
+        }
+        else if (!str.empty()) {
+            str += " ";
+        }
+        str += selector.toString();
+    }
+    return str;
+}
+
+// queries passed as strings are usually literals that get run over and over
+static std::optional<NodeQuery> getCachedQuery(std::string const& queryStr) {
+    // mods generating queries on the fly shouldn't make this grow forever
+    constexpr size_t MAX_CACHED_QUERIES = 256;
+    static std::unordered_map<std::string, NodeQuery> s_cache;
+
+    if (auto it = s_cache.find(queryStr); it != s_cache.end()) {
+        return it->second;
+    }
+    auto res = NodeQuery::compile(queryStr);
     if (!res) {
         log::error("Invalid CCNode::querySelector query '{}': {}", queryStr, res.unwrapErr());
-        return nullptr;
+        return std::nullopt;
+    }
+    if (s_cache.size() >= MAX_CACHED_QUERIES) {
+        s_cache.clear();
     }
-    auto query = std::move(res.unwrap());
-    log::info("parsed query: {}", query->toString());
-    return query->match(this);
+    return s_cache.emplace(queryStr, std::move(res).unwrap()).first->second;
+}
+
+CCNode* CCNode::querySelector(std::string const& queryStr) {
+    auto query = getCachedQuery(queryStr);
+    return query ? query->match(this) : nullptr;
+}
+
+CCNode* CCNode::querySelector(NodeQuery const& query) {
+    return query.match(this);
+}
+
+std::vector<CCNode*> CCNode::querySelectorAll(std::string const& queryStr) {
+    auto query = getCachedQuery(queryStr);
+    return query ? query->matchAll(this) : std::vector<CCNode*>();
+}
+
+std::vector<CCNode*> CCNode::querySelectorAll(NodeQuery const& query) {
+    return query.matchAll(this);
 }
 
 void CCNode::removeChildByID(std::string const& id) {
@@ -318,7 +694,8 @@ void CCNode::setLayout(Layout* layout, bool apply, bool respectAnchor) {
 }
 
 Layout* CCNode::getLayout() {
-    return GeodeNodeMetadata::set(this)->m_layout.data();
+    auto meta = GeodeNodeMetadata::get(this);
+    return meta ? meta->m_layout.data() : nullptr;
 }
 
 void CCNode::setLayoutOptions(LayoutOptions* options, bool apply) {
@@ -329,14 +706,15 @@ void CCNode::setLayoutOptions(LayoutOptions* options, bool apply) {
 }
 
 LayoutOptions* CCNode::getLayoutOptions() {
-    return GeodeNodeMetadata::set(this)->m_layoutOptions.data();
+    auto meta = GeodeNodeMetadata::get(this);
+    return meta ? meta->m_layoutOptions.data() : nullptr;
 }
 
 void CCNode::updateLayout(bool updateChildOrder) {
     if (updateChildOrder) {
         this->sortAllChildren();
     }
-    if (auto layout = GeodeNodeMetadata::set(this)->m_layout.data()) {
+    if (auto layout = this->getLayout()) {
         layout->apply(this);
     }
 }
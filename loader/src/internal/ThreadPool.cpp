@@ -0,0 +1,85 @@
+#include "ThreadPool.hpp"
+
+#include <Geode/utils/general.hpp>
+#include <algorithm>
+#include <fmt/format.h>
+
+using namespace geode::prelude;
+
+ThreadPool::ThreadPool(std::string name, size_t threadCount) : m_name(std::move(name)) {
+    if (threadCount == 0) {
+        threadCount = getDefaultThreadCount();
+    }
+    m_threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i += 1) {
+        m_threads.emplace_back([this, i] {
+            utils::thread::setName(fmt::format("{} #{}", m_name, i + 1));
+            this->work();
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_jobAvailable.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::work() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(m_mutex);
+            m_jobAvailable.wait(lock, [this] {
+                return m_stopping || !m_jobs.empty();
+            });
+            // finish the remaining jobs before stopping
+            if (m_jobs.empty()) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_busyCount += 1;
+        }
+
+        job();
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_busyCount -= 1;
+            if (m_busyCount == 0 && m_jobs.empty()) {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
+
+void ThreadPool::push(Job&& job) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [this] {
+        return m_busyCount == 0 && m_jobs.empty();
+    });
+}
+
+size_t ThreadPool::getThreadCount() const {
+    return m_threads.size();
+}
+
+size_t ThreadPool::getDefaultThreadCount() {
+    // unzipping and scanning is mostly disk bound, so going wider than this
+    // just makes the workers fight over the disk
+    return std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include <Geode/utils/MiniFunction.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace geode {
+    /**
+     * A fixed-size pool of worker threads for loader-internal background work
+     * (unzipping mods, scanning packages, etc.). Jobs are run in FIFO order.
+     * Destroying the pool finishes all queued jobs and joins the workers
+     */
+    class ThreadPool final {
+    public:
+        using Job = utils::MoveOnlyFunction<void()>;
+
+    protected:
+        std::string m_name;
+        std::vector<std::thread> m_threads;
+        std::deque<Job> m_jobs;
+        std::mutex m_mutex;
+        std::condition_variable m_jobAvailable;
+        std::condition_variable m_idle;
+        size_t m_busyCount = 0;
+        bool m_stopping = false;
+
+        void work();
+
+    public:
+        /**
+         * Create a pool
+         * @param name Name given to the worker threads
+         * @param threadCount Number of workers; 0 picks a count based on
+         * the number of hardware threads
+         */
+        ThreadPool(std::string name, size_t threadCount = 0);
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+        ~ThreadPool();
+
+        /**
+         * Queue a job to be run on one of the workers
+         */
+        void push(Job&& job);
+        /**
+         * Block until every queued job has finished running
+         */
+        void wait();
+
+        size_t getThreadCount() const;
+
+        static size_t getDefaultThreadCount();
+    };
+}
@@ -1,6 +1,7 @@
 #include "crashlog.hpp"
 #include <fmt/core.h>
 #include "about.hpp"
+#include "../loader/LogImpl.hpp"
 #include "../loader/ModImpl.hpp"
 #include <Geode/Utils.hpp>
 
@@ -58,6 +59,9 @@ std::string crashlog::writeCrashlog(geode::Mod* faultyMod, std::string const& in
 }
 
 std::string crashlog::writeCrashlog(geode::Mod* faultyMod, std::string const& info, std::string const& stacktrace, std::string const& registers, std::filesystem::path& outPath) {
+    // make sure everything logged before the crash ends up in the log file
+    log::Logger::get()->flush();
+
     // make sure crashlog directory exists
     (void)utils::file::createDirectoryAll(crashlog::getCrashLogDirectory());
 
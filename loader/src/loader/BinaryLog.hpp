@@ -0,0 +1,97 @@
+#pragma once
+
+// The binary log format, written by the Logger when binary logging is enabled
+// and read back by tools/logconv. This is shared with a host-side tool, so it
+// can't depend on anything else from Geode
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace geode::log::binary {
+    // files start with the magic followed by the format version as a u32
+    constexpr char MAGIC[4] = { 'G', 'L', 'O', 'G' };
+    constexpr uint32_t VERSION = 2;
+
+    constexpr std::string_view FILE_EXTENSION = ".glog";
+
+    enum class RecordType : uint8_t {
+        // u32 id, string value; defines a string that later records refer to
+        // by id, so mod IDs and thread names are only written once
+        String = 1,
+        // i64 microseconds since the unix epoch, u8 severity, u32 source id,
+        // u32 thread id, i32 nest count, string message; since version 2
+        // followed by the u32 id of the mod ID, which is empty for logs that
+        // aren't from a mod (the source is the mod's display name)
+        Log = 2,
+    };
+
+    // integers are written as-is, which is little endian on every platform
+    // Geode runs on; strings are a u32 length followed by the bytes
+    template <class T>
+        requires std::is_integral_v<T> || std::is_enum_v<T>
+    void write(std::string& out, T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    inline void write(std::string& out, std::string_view str) {
+        write(out, static_cast<uint32_t>(str.size()));
+        out.append(str);
+    }
+
+    inline std::string header() {
+        std::string out(MAGIC, sizeof(MAGIC));
+        write(out, VERSION);
+        return out;
+    }
+
+    class Reader final {
+        std::string_view m_data;
+        size_t m_pos = 0;
+        uint32_t m_version = 0;
+
+    public:
+        Reader(std::string_view data) : m_data(data) {}
+
+        bool atEnd() const {
+            return m_pos >= m_data.size();
+        }
+
+        template <class T>
+            requires std::is_integral_v<T> || std::is_enum_v<T>
+        bool read(T& value) {
+            if (m_data.size() - m_pos < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&value, m_data.data() + m_pos, sizeof(T));
+            m_pos += sizeof(T);
+            return true;
+        }
+
+        bool read(std::string_view& str) {
+            uint32_t size;
+            if (!this->read(size) || m_data.size() - m_pos < size) {
+                return false;
+            }
+            str = m_data.substr(m_pos, size);
+            m_pos += size;
+            return true;
+        }
+
+        bool readHeader() {
+            if (m_data.size() < sizeof(MAGIC) || std::memcmp(m_data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+                return false;
+            }
+            m_pos = sizeof(MAGIC);
+            return this->read(m_version) && m_version >= 1 && m_version <= VERSION;
+        }
+
+        uint32_t getVersion() const {
+            return m_version;
+        }
+    };
+}
@@ -1,25 +1,100 @@
 #include <Geode/loader/Event.hpp>
 #include <Geode/utils/ranges.hpp>
+#include <algorithm>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <typeindex>
+#include <unordered_map>
 
 using namespace geode::prelude;
 
+namespace {
+    struct ListenerEventType {
+        std::type_index type;
+        EventListenerProtocol::EventMatcher matcher;
+    };
+
+    // set through EventListenerProtocol::setEventType
+    std::mutex s_listenerTypesMutex;
+    std::unordered_map<EventListenerProtocol*, ListenerEventType>& listenerTypes() {
+        static std::unordered_map<EventListenerProtocol*, ListenerEventType> types;
+        return types;
+    }
+
+    std::optional<ListenerEventType> getListenerEventType(EventListenerProtocol* listener) {
+        std::unique_lock lock(s_listenerTypesMutex);
+        auto it = listenerTypes().find(listener);
+        if (it == listenerTypes().end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    struct Bucket {
+        // null for listeners that never said what they handle, which are
+        // offered every event
+        EventListenerProtocol::EventMatcher matcher = nullptr;
+        // newest listeners first, tagged with the order they were added in
+        // so that the order across buckets is kept when dispatching
+        std::deque<std::pair<size_t, EventListenerProtocol*>> listeners;
+        bool hasRemoved = false;
+    };
+
+    struct DispatchEntry {
+        size_t generation = 0;
+        std::vector<Bucket*> buckets;
+    };
+}
+
+struct DefaultEventListenerPool::Data {
+    size_t m_locked = 0;
+    std::mutex m_mutex;
+    size_t m_nextOrder = 0;
+    Bucket m_untyped;
+    std::unordered_map<std::type_index, std::unique_ptr<Bucket>> m_buckets;
+    std::unordered_map<EventListenerProtocol*, Bucket*> m_listenerBuckets;
+    std::vector<std::pair<EventListenerProtocol*, Bucket*>> m_toAdd;
+    // buckets with listeners that were removed while locked
+    std::vector<Bucket*> m_dirtyBuckets;
+    // which buckets an event of some type has to go through; bumping the
+    // generation invalidates all of these
+    std::unordered_map<std::type_index, DispatchEntry> m_dispatch;
+    size_t m_generation = 1;
+};
+
 DefaultEventListenerPool::DefaultEventListenerPool() : m_data(new Data) {}
 
+DefaultEventListenerPool::~DefaultEventListenerPool() = default;
+
 bool DefaultEventListenerPool::add(EventListenerProtocol* listener) {
     if (!m_data) m_data = std::make_unique<Data>();
 
+    auto type = getListenerEventType(listener);
+
     std::unique_lock lock(m_data->m_mutex);
-    if (ranges::contains(m_data->m_listeners, listener) || ranges::contains(m_data->m_toAdd, listener)) {
+    if (m_data->m_listenerBuckets.contains(listener)) {
         return false;
     }
-    
+
+    auto bucket = &m_data->m_untyped;
+    if (type) {
+        auto& typed = m_data->m_buckets[type->type];
+        if (!typed) {
+            typed = std::make_unique<Bucket>();
+            typed->matcher = type->matcher;
+            m_data->m_generation += 1;
+        }
+        bucket = typed.get();
+    }
+    m_data->m_listenerBuckets.insert({ listener, bucket });
+
     if (m_data->m_locked) {
-        m_data->m_toAdd.push_back(listener);
+        m_data->m_toAdd.push_back({ listener, bucket });
     }
     else {
         // insert listeners at the start so new listeners get priority
-        m_data->m_listeners.push_front(listener);
+        bucket->listeners.push_front({ m_data->m_nextOrder++, listener });
     }
     return true;
 }
@@ -28,41 +103,151 @@ void DefaultEventListenerPool::remove(EventListenerProtocol* listener) {
     if (!m_data) m_data = std::make_unique<Data>();
 
     std::unique_lock lock(m_data->m_mutex);
+    auto it = m_data->m_listenerBuckets.find(listener);
+    if (it == m_data->m_listenerBuckets.end()) {
+        return;
+    }
+    auto bucket = it->second;
+    m_data->m_listenerBuckets.erase(it);
+
     if (m_data->m_locked) {
-        for (size_t i = 0 ; i < m_data->m_listeners.size(); i++) {
-            if (m_data->m_listeners[i] == listener) {
-                m_data->m_listeners[i] = nullptr;
+        for (auto& [_, h] : bucket->listeners) {
+            if (h == listener) {
+                h = nullptr;
+                if (!bucket->hasRemoved) {
+                    bucket->hasRemoved = true;
+                    m_data->m_dirtyBuckets.push_back(bucket);
+                }
             }
         }
     }
     else {
-        ranges::remove(m_data->m_listeners, listener);
+        std::erase_if(bucket->listeners, [listener](auto const& pair) {
+            return pair.second == listener;
+        });
     }
-    ranges::remove(m_data->m_toAdd, listener);
+    std::erase_if(m_data->m_toAdd, [listener](auto const& pair) {
+        return pair.first == listener;
+    });
 }
 
 ListenerResult DefaultEventListenerPool::handle(Event* event) {
+    if (this->handleListeners(event) == ListenerResult::Stop) {
+        return ListenerResult::Stop;
+    }
+    if (this == DefaultEventListenerPool::get()) {
+        return KeyedEventListenerPool::handleFromDefault(event);
+    }
+    return ListenerResult::Propagate;
+}
+
+ListenerResult DefaultEventListenerPool::handleListeners(Event* event) {
     if (!m_data) m_data = std::make_unique<Data>();
 
     auto res = ListenerResult::Propagate;
-    m_data->m_locked += 1;
     std::unique_lock lock(m_data->m_mutex);
-    for (auto h : m_data->m_listeners) {
-        lock.unlock();
-        if (h && h->handle(event) == ListenerResult::Stop) {
-            res = ListenerResult::Stop;
-            lock.lock();
-            break;
+    bool outermost = m_data->m_locked == 0;
+    m_data->m_locked += 1;
+
+    // figure out which buckets this event can match; this only needs the
+    // type of the event so it's cached, unless something else is already
+    // iterating the cached lists in which case they must not be touched
+    std::vector<Bucket*> nestedBuckets;
+    auto collectBuckets = [&](std::vector<Bucket*>& into) {
+        into.clear();
+        for (auto& [_, bucket] : m_data->m_buckets) {
+            if (bucket->matcher(event)) {
+                into.push_back(bucket.get());
+            }
         }
+    };
+    std::vector<Bucket*>* buckets;
+    auto& entry = m_data->m_dispatch[std::type_index(typeid(*event))];
+    if (entry.generation == m_data->m_generation) {
+        buckets = &entry.buckets;
+    }
+    else if (outermost) {
+        collectBuckets(entry.buckets);
+        entry.generation = m_data->m_generation;
+        buckets = &entry.buckets;
+    }
+    else {
+        collectBuckets(nestedBuckets);
+        buckets = &nestedBuckets;
+    }
+
+    // the buckets can't be added to while locked, only have entries nulled,
+    // so plain indices are safe to keep across the unlocked calls
+    auto callListener = [&](EventListenerProtocol* h) {
+        if (!h) {
+            return false;
+        }
+        lock.unlock();
+        auto stop = h->handle(event) == ListenerResult::Stop;
         lock.lock();
+        return stop;
+    };
+    // listeners that didn't say what they handle get offered everything
+    auto untyped = &m_data->m_untyped;
+    auto bucketCount = buckets->size() + (untyped->listeners.empty() ? 0 : 1);
+    if (bucketCount == 1) {
+        auto& listeners = buckets->empty() ? untyped->listeners : buckets->front()->listeners;
+        for (size_t i = 0; i < listeners.size(); i += 1) {
+            if (callListener(listeners[i].second)) {
+                res = ListenerResult::Stop;
+                break;
+            }
+        }
+    }
+    else if (bucketCount > 1) {
+        // merge the buckets newest-first, same order as if they were all
+        // in one list
+        if (!untyped->listeners.empty()) {
+            if (buckets != &nestedBuckets) {
+                nestedBuckets = *buckets;
+                buckets = &nestedBuckets;
+            }
+            buckets->push_back(untyped);
+        }
+        std::vector<size_t> positions(buckets->size(), 0);
+        while (true) {
+            Bucket* next = nullptr;
+            size_t* nextPos = nullptr;
+            for (size_t b = 0; b < buckets->size(); b += 1) {
+                auto bucket = (*buckets)[b];
+                auto pos = positions[b];
+                if (pos < bucket->listeners.size() && (
+                    !next || bucket->listeners[pos].first > next->listeners[*nextPos].first
+                )) {
+                    next = bucket;
+                    nextPos = &positions[b];
+                }
+            }
+            if (!next) {
+                break;
+            }
+            auto h = next->listeners[*nextPos].second;
+            *nextPos += 1;
+            if (callListener(h)) {
+                res = ListenerResult::Stop;
+                break;
+            }
+        }
     }
+
     m_data->m_locked -= 1;
-    // only mutate listeners once nothing is iterating 
+    // only mutate listeners once nothing is iterating
     // (if there are recursive handle calls)
     if (m_data->m_locked == 0) {
-        ranges::remove(m_data->m_listeners, nullptr);
-        for (auto listener : m_data->m_toAdd) {
-            m_data->m_listeners.push_front(listener);
+        for (auto bucket : m_data->m_dirtyBuckets) {
+            std::erase_if(bucket->listeners, [](auto const& pair) {
+                return pair.second == nullptr;
+            });
+            bucket->hasRemoved = false;
+        }
+        m_data->m_dirtyBuckets.clear();
+        for (auto& [listener, bucket] : m_data->m_toAdd) {
+            bucket->listeners.push_front({ m_data->m_nextOrder++, listener });
         }
         m_data->m_toAdd.clear();
     }
@@ -78,15 +263,185 @@ DefaultEventListenerPool* DefaultEventListenerPool::get() {
     return inst;
 }
 
+namespace {
+    struct KeyedPoolEntry {
+        std::weak_ptr<void const> key;
+        KeyedEventListenerPool* pool;
+    };
+
+    std::mutex s_keyedPoolsMutex;
+    std::unordered_map<void const*, KeyedPoolEntry>& keyedPools() {
+        static std::unordered_map<void const*, KeyedPoolEntry> pools;
+        return pools;
+    }
+    // pools whose key has been destroyed are only looked for once there 
+    // are this many
+    size_t s_keyedPoolsSweepAt = 64;
+
+    // which keyed pools have listeners for which event type, for events 
+    // posted to the default pool
+    std::unordered_map<std::type_index, std::unordered_map<KeyedEventListenerPool*, size_t>>& keyedPoolsByType() {
+        static std::unordered_map<std::type_index, std::unordered_map<KeyedEventListenerPool*, size_t>> pools;
+        return pools;
+    }
+    std::unordered_map<EventListenerProtocol*, std::type_index>& keyedListenerTypes() {
+        static std::unordered_map<EventListenerProtocol*, std::type_index> types;
+        return types;
+    }
+    std::atomic_size_t s_keyedListenerCount = 0;
+
+    // the address alone isn't enough, something else may live there now
+    bool isSameKey(std::weak_ptr<void const> const& a, std::shared_ptr<void const> const& b) {
+        return !a.owner_before(b) && !b.owner_before(a);
+    }
+}
+
+KeyedEventListenerPool::KeyedEventListenerPool() = default;
+
+bool KeyedEventListenerPool::isUnused() {
+    std::unique_lock lock(m_data->m_mutex);
+    return m_data->m_listenerBuckets.empty() && !m_data->m_locked && m_pins == 0;
+}
+
+void KeyedEventListenerPool::drop() {
+    // s_keyedPoolsMutex is held by the caller
+    m_released = true;
+    if (this->isUnused()) {
+        delete this;
+    }
+}
+
+bool KeyedEventListenerPool::add(EventListenerProtocol* listener) {
+    std::unique_lock lock(s_keyedPoolsMutex);
+    if (!DefaultEventListenerPool::add(listener)) {
+        return false;
+    }
+    if (auto type = getListenerEventType(listener)) {
+        keyedPoolsByType()[type->type][this] += 1;
+        keyedListenerTypes().insert({ listener, type->type });
+        s_keyedListenerCount += 1;
+    }
+    return true;
+}
+
+void KeyedEventListenerPool::remove(EventListenerProtocol* listener) {
+    std::unique_lock lock(s_keyedPoolsMutex);
+    DefaultEventListenerPool::remove(listener);
+
+    auto typeIt = keyedListenerTypes().find(listener);
+    if (typeIt != keyedListenerTypes().end()) {
+        auto poolsIt = keyedPoolsByType().find(typeIt->second);
+        if (poolsIt != keyedPoolsByType().end() && --poolsIt->second[this] == 0) {
+            poolsIt->second.erase(this);
+            if (poolsIt->second.empty()) {
+                keyedPoolsByType().erase(poolsIt);
+            }
+        }
+        keyedListenerTypes().erase(typeIt);
+        s_keyedListenerCount -= 1;
+    }
+
+    // listeners usually outlive their key by a bit (the filter holding
+    // onto the key is destroyed before the listener disables itself), so
+    // the last one out frees the pool
+    if (m_released && this->isUnused()) {
+        delete this;
+    }
+}
+
+ListenerResult KeyedEventListenerPool::handle(Event* event) {
+    if (this->handleListeners(event) == ListenerResult::Stop) {
+        return ListenerResult::Stop;
+    }
+    return DefaultEventListenerPool::get()->handleListeners(event);
+}
+
+ListenerResult KeyedEventListenerPool::handleFromDefault(Event* event) {
+    if (s_keyedListenerCount == 0) {
+        return ListenerResult::Propagate;
+    }
+
+    // code built against older headers posts events like Task's straight to
+    // the default pool, so offer them to every keyed pool that listens for
+    // that type; their filters check the key themselves
+    std::vector<KeyedEventListenerPool*> pools;
+    {
+        std::unique_lock lock(s_keyedPoolsMutex);
+        auto it = keyedPoolsByType().find(std::type_index(typeid(*event)));
+        if (it == keyedPoolsByType().end()) {
+            return ListenerResult::Propagate;
+        }
+        for (auto& [pool, _] : it->second) {
+            pool->m_pins += 1;
+            pools.push_back(pool);
+        }
+    }
+
+    auto res = ListenerResult::Propagate;
+    for (auto pool : pools) {
+        if (pool->handleListeners(event) == ListenerResult::Stop) {
+            res = ListenerResult::Stop;
+            break;
+        }
+    }
+
+    std::unique_lock lock(s_keyedPoolsMutex);
+    for (auto pool : pools) {
+        pool->m_pins -= 1;
+        if (pool->m_released && pool->isUnused()) {
+            delete pool;
+        }
+    }
+    return res;
+}
+
+KeyedEventListenerPool* KeyedEventListenerPool::get(std::shared_ptr<void const> const& key) {
+    std::unique_lock lock(s_keyedPoolsMutex);
+    auto& pools = keyedPools();
+    if (auto it = pools.find(key.get()); it != pools.end()) {
+        if (isSameKey(it->second.key, key)) {
+            return it->second.pool;
+        }
+        it->second.pool->drop();
+        pools.erase(it);
+    }
+
+    // keys don't say when they're destroyed, so every now and then free 
+    // the pools of ones that are gone
+    if (pools.size() >= s_keyedPoolsSweepAt) {
+        std::erase_if(pools, [](auto& pair) {
+            if (!pair.second.key.expired()) {
+                return false;
+            }
+            pair.second.pool->drop();
+            return true;
+        });
+        s_keyedPoolsSweepAt = std::max<size_t>(64, pools.size() * 2);
+    }
+
+    auto pool = new KeyedEventListenerPool();
+    pools.insert({ key.get(), KeyedPoolEntry { key, pool } });
+    return pool;
+}
+
+EventListenerPool* KeyedEventListenerPool::getForPosting(std::shared_ptr<void const> const& key) {
+    std::unique_lock lock(s_keyedPoolsMutex);
+    auto it = keyedPools().find(key.get());
+    if (it != keyedPools().end() && isSameKey(it->second.key, key)) {
+        return it->second.pool;
+    }
+    return DefaultEventListenerPool::get();
+}
+
 EventListenerPool* EventListenerProtocol::getPool() const {
     return DefaultEventListenerPool::get();
 }
 
 bool EventListenerProtocol::enable() {
-    // virtual calls from destructors always call the base class so we gotta 
+    // virtual calls from destructors always call the base class so we gotta
     // store the subclass' pool in a member to be able to access it in disable
-    // this is actually better because now regardless of what getPool() does 
-    // we can always be assured that whatever pool it returns this listener 
+    // this is actually better because now regardless of what getPool() does
+    // we can always be assured that whatever pool it returns this listener
     // will be removed from that pool and can't be in multiple pools at once
     if (m_pool || !(m_pool = this->getPool())) {
         return false;
@@ -94,6 +449,13 @@ bool EventListenerProtocol::enable() {
     return m_pool->add(this);
 }
 
+void EventListenerProtocol::updatePool() {
+    if (m_pool && m_pool != this->getPool()) {
+        this->disable();
+        this->enable();
+    }
+}
+
 void EventListenerProtocol::disable() {
     if (m_pool) {
         m_pool->remove(this);
@@ -101,8 +463,15 @@ void EventListenerProtocol::disable() {
     }
 }
 
+void EventListenerProtocol::setEventType(std::type_info const& type, EventMatcher matcher) {
+    std::unique_lock lock(s_listenerTypesMutex);
+    listenerTypes().insert_or_assign(this, ListenerEventType { std::type_index(type), matcher });
+}
+
 EventListenerProtocol::~EventListenerProtocol() {
     this->disable();
+    std::unique_lock lock(s_listenerTypesMutex);
+    listenerTypes().erase(this);
 }
 
 Event::~Event() {}
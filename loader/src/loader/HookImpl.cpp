@@ -44,30 +44,37 @@ std::shared_ptr<Hook> Hook::Impl::create(
     });
 }
 
-Result<> Hook::Impl::enable() {
-    if (m_enabled) {
-        return Ok();
-    }
-
+bool Hook::Impl::isPlaceholder() const {
     // During a transition between updates when it's important to get a
     // non-functional version that compiles, address 0x9999999 is used to mark
     // functions not yet RE'd but that would prevent compilation
-    if ((uintptr_t)m_address == (geode::base::get() + 0x9999999)) {
-        if (m_owner) {
-            log::warn(
-                "Hook {} for {} uses placeholder address, refusing to hook",
-                m_displayName, m_owner->getID()
-            );
-        }
-        else {
-            log::warn("Hook {} uses placeholder address, refusing to hook", m_displayName);
-        }
-        return Ok();
+    if ((uintptr_t)m_address != (geode::base::get() + 0x9999999)) {
+        return false;
     }
+    if (m_owner) {
+        log::warn(
+            "Hook {} for {} uses placeholder address, refusing to hook",
+            m_displayName, m_owner->getID()
+        );
+    }
+    else {
+        log::warn("Hook {} uses placeholder address, refusing to hook", m_displayName);
+    }
+    return true;
+}
 
-    GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getOrCreateHandler(m_address, m_handlerMetadata));
+void Hook::Impl::enableWithHandler(tulip::hook::HandlerHandle handler) {
     m_handle = tulip::hook::createHook(handler, m_detour, m_hookMetadata);
     m_enabled = true;
+}
+
+Result<> Hook::Impl::enable() {
+    if (m_enabled || this->isPlaceholder()) {
+        return Ok();
+    }
+
+    GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getOrCreateHandler(m_address, m_handlerMetadata));
+    this->enableWithHandler(handler);
 
     if (m_owner) {
         log::debug("Enabled {} hook at {} for {}", m_displayName, m_address, m_owner->getID());
@@ -50,6 +50,11 @@ public:
     Result<> enable();
     Result<> disable();
 
+    // logs a warning if this hook targets the placeholder address
+    bool isPlaceholder() const;
+    // enables the hook on a handler already created for its address
+    void enableWithHandler(tulip::hook::HandlerHandle handler);
+
     uintptr_t getAddress() const;
     std::string_view getDisplayName() const;
     matjson::Value getRuntimeInfo() const;
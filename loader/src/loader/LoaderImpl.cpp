@@ -1,6 +1,7 @@
 #include "LoaderImpl.hpp"
 #include <cocos2d.h>
 
+#include "HookImpl.hpp"
 #include "ModImpl.hpp"
 #include "ModMetadataImpl.hpp"
 #include "LogImpl.hpp"
@@ -78,6 +79,31 @@ Result<> Loader::Impl::setup() {
         log::popNest();
     }
 
+    if (auto budget = this->getLaunchArgument("main-thread-queue-budget")) {
+        if (auto ms = numFromString<float>(*budget)) {
+            m_mainThreadQueueBudget = std::chrono::microseconds(static_cast<int64_t>(ms.unwrap() * 1000.f));
+            log::debug("Main thread queue budget set to {}ms", ms.unwrap());
+        }
+        else {
+            log::warn("Invalid main thread queue budget \"{}\"", *budget);
+        }
+    }
+
+    if (this->getLaunchFlag("sync-logging")) {
+        log::Logger::get()->setAsync(false);
+    }
+    if (this->getLaunchFlag("binary-log")) {
+        log::Logger::get()->enableBinaryOutput();
+    }
+    if (auto limit = this->getLaunchArgument("log-history-size")) {
+        if (auto size = numFromString<size_t>(*limit)) {
+            log::Logger::get()->setHistoryLimit(size.unwrap());
+        }
+        else {
+            log::warn("Invalid log history size \"{}\"", *limit);
+        }
+    }
+
     // on some platforms, using the crash handler overrides more convenient native handlers
     if (!this->getLaunchFlag("disable-crash-handler")) {
         log::debug("Setting up crash handler");
@@ -264,51 +290,146 @@ void Loader::Impl::addProblem(LoadProblem const& problem) {
 
 // Dependencies and refreshing
 
+static std::filesystem::path getModIndexPath() {
+    return dirs::getGeodeDir() / "mod-index.json";
+}
+
+std::string Loader::Impl::getFileStamp(std::filesystem::path const& path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return "";
+    auto modifiedDate = std::filesystem::last_write_time(path, ec);
+    if (ec) return "";
+    auto modifiedCount = std::chrono::duration_cast<std::chrono::milliseconds>(modifiedDate.time_since_epoch());
+    return fmt::format("{}:{}", size, modifiedCount.count());
+}
+
 void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
+    std::vector<std::filesystem::path> packages;
     for (auto const& dir : m_modSearchDirectories) {
         log::debug("Searching {}", dir);
-        log::pushNest();
         for (auto const& entry : std::filesystem::directory_iterator(dir)) {
             if (!std::filesystem::is_regular_file(entry) ||
                 entry.path().extension() != GEODE_MOD_EXTENSION)
                 continue;
+            packages.push_back(entry.path());
+        }
+    }
 
-            log::debug("Found {}", entry.path().filename());
-            log::pushNest();
+    // packages that haven't changed since the last launch don't need to be
+    // opened at all, their mod.json is already in the index
+    matjson::Value oldIndex = matjson::Object();
+    if (std::filesystem::exists(getModIndexPath())) {
+        auto res = file::readJson(getModIndexPath());
+        if (res && res.unwrap().is_object()) {
+            oldIndex = res.unwrap();
+        }
+        else {
+            log::warn("Mod index is invalid, rebuilding it");
+        }
+    }
+    std::vector<std::string> stamps;
+    std::vector<std::optional<ModJson>> indexed;
+    size_t indexedCount = 0;
+    for (auto const& path : packages) {
+        // if a package's stamp hasn't changed, neither has its mod.json
+        auto stamp = getFileStamp(path);
+        auto key = path.string();
+        if (
+            !stamp.empty() && oldIndex.contains(key) &&
+            oldIndex[key].is_object() &&
+            oldIndex[key].contains("stamp") && oldIndex[key]["stamp"].is_string() &&
+            oldIndex[key]["stamp"].as_string() == stamp &&
+            oldIndex[key].contains("json")
+        ) {
+            indexed.push_back(oldIndex[key]["json"]);
+            indexedCount += 1;
+        }
+        else {
+            indexed.push_back(std::nullopt);
+        }
+        stamps.push_back(std::move(stamp));
+    }
 
-            auto res = ModMetadata::createFromGeodeFile(entry.path());
-            if (!res) {
-                this->addProblem({
-                    LoadProblem::Type::InvalidFile,
-                    entry.path(),
-                    res.unwrapErr()
-                });
-                log::error("Failed to queue: {}", res.unwrapErr());
-                log::popNest();
-                continue;
+    // reading mod.json out of every package is by far the slowest part of
+    // this, so do that in parallel and only then go through the results
+    if (!m_workerPool) {
+        m_workerPool = std::make_unique<ThreadPool>("Mod Loader");
+    }
+    std::vector<std::optional<Result<ModMetadata>>> results(packages.size());
+    for (size_t i = 0; i < packages.size(); i += 1) {
+        m_workerPool->push([&packages, &indexed, &stamps, &results, i]() {
+            if (indexed[i]) {
+                results[i] = ModMetadata::Impl::createFromIndex(packages[i], *indexed[i]);
             }
-            auto modMetadata = res.unwrap();
-
-            log::debug("id: {}", modMetadata.getID());
-            log::debug("version: {}", modMetadata.getVersion());
-            log::debug("early: {}", modMetadata.needsEarlyLoad() ? "yes" : "no");
-
-            if (std::find_if(modQueue.begin(), modQueue.end(), [&](auto& item) {
-                    return modMetadata.getID() == item.getID();
-                }) != modQueue.end()) {
-                this->addProblem({
-                    LoadProblem::Type::Duplicate,
-                    modMetadata,
-                    "A mod with the same ID is already present."
-                });
-                log::error("Failed to queue: a mod with the same ID is already queued");
-                log::popNest();
-                continue;
+            // the index being out of date shouldn't stop the mod from loading
+            if (!results[i] || !*results[i]) {
+                // the package stays in the mods folder, so there's no need to
+                // pay for the markdown files until the UI actually wants them
+                results[i] = ModMetadata::Impl::createFromGeodeFile(packages[i], false);
+            }
+            if (auto& res = *results[i]) {
+                ModMetadataImpl::getImpl(res.unwrap()).m_packageStamp = stamps[i];
             }
+        });
+    }
+    m_workerPool->wait();
+
+    log::debug("Read {} packages from the mod index, {} from disk", indexedCount, packages.size() - indexedCount);
+
+    matjson::Value newIndex = matjson::Object();
+    for (size_t i = 0; i < packages.size(); i += 1) {
+        auto const& res = results[i].value();
+        if (res && !stamps[i].empty()) {
+            newIndex[packages[i].string()] = matjson::Object {
+                { "stamp", stamps[i] },
+                { "json", res.unwrap().getRawJSON() },
+            };
+        }
+    }
+    if (newIndex != oldIndex) {
+        auto res = file::writeString(getModIndexPath(), newIndex.dump(matjson::NO_INDENTATION));
+        if (!res) {
+            log::warn("Unable to save mod index: {}", res.unwrapErr());
+        }
+    }
+
+    std::unordered_set<std::string> queuedIDs;
+    for (size_t i = 0; i < packages.size(); i += 1) {
+        auto const& path = packages[i];
+        auto& res = results[i].value();
+
+        log::debug("Found {}", path.filename());
+        log::pushNest();
 
-            modQueue.push_back(modMetadata);
+        if (!res) {
+            this->addProblem({
+                LoadProblem::Type::InvalidFile,
+                path,
+                res.unwrapErr()
+            });
+            log::error("Failed to queue: {}", res.unwrapErr());
             log::popNest();
+            continue;
+        }
+        auto modMetadata = std::move(res.unwrap());
+
+        log::debug("id: {}", modMetadata.getID());
+        log::debug("version: {}", modMetadata.getVersion());
+        log::debug("early: {}", modMetadata.needsEarlyLoad() ? "yes" : "no");
+
+        if (!queuedIDs.insert(modMetadata.getID()).second) {
+            this->addProblem({
+                LoadProblem::Type::Duplicate,
+                modMetadata,
+                "A mod with the same ID is already present."
+            });
+            log::error("Failed to queue: a mod with the same ID is already queued");
+            log::popNest();
+            continue;
         }
+
+        modQueue.push_back(std::move(modMetadata));
         log::popNest();
     }
 }
@@ -403,35 +524,9 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
     }
 
     m_currentlyLoadingMod = node;
-    m_refreshingModCount += 1;
     m_refreshedModCount += 1;
     m_lateRefreshedModCount += early ? 0 : 1;
 
-    auto unzipFunction = [this, node]() {
-        log::debug("Unzip");
-        auto res = node->m_impl->unzipGeodeFile(node->getMetadata());
-        return res;
-    };
-
-    auto loadFunction = [this, node, early]() {
-        if (node->shouldLoad()) {
-            log::debug("Load");
-            auto res = node->m_impl->loadBinary();
-            if (!res) {
-                this->addProblem({
-                    LoadProblem::Type::LoadFailed,
-                    node,
-                    res.unwrapErr()
-                });
-                log::error("Failed to load binary: {}", res.unwrapErr());
-                m_refreshingModCount -= 1;
-                return;
-            }
-        }
-
-        m_refreshingModCount -= 1;
-    };
-
     {   // version checking
         if (auto reason = node->getMetadata().m_impl->m_softInvalidReason) {
             this->addProblem({
@@ -440,7 +535,6 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
                 reason.value()
             });
             log::error("{}", reason.value());
-            m_refreshingModCount -= 1;
             log::popNest();
             return;
         }
@@ -453,7 +547,6 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
                 res.unwrapErr()
             });
             log::error("{}", res.unwrapErr());
-            m_refreshingModCount -= 1;
             log::popNest();
             return;
         }
@@ -469,53 +562,114 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
                 )
             });
             log::error("Unsupported Geode version: {}", node->getMetadata().getGeodeVersion());
-            m_refreshingModCount -= 1;
             log::popNest();
             return;
         }
     }
 
+    // late mods have already been unzipped by startModUnzips
+    Result<> unzipRes = Ok();
     if (early) {
-        auto res = unzipFunction();
+        log::debug("Unzip");
+        unzipRes = node->m_impl->unzipGeodeFile(node->getMetadata());
+    }
+    else if (auto it = m_unzipResults.find(node); it != m_unzipResults.end()) {
+        unzipRes = std::move(it->second);
+        m_unzipResults.erase(it);
+    }
+    else {
+        unzipRes = Err("Mod was never unzipped");
+    }
+    if (!unzipRes) {
+        this->addProblem({
+            LoadProblem::Type::UnzipFailed,
+            node,
+            unzipRes.unwrapErr()
+        });
+        log::error("Failed to unzip: {}", unzipRes.unwrapErr());
+        log::popNest();
+        return;
+    }
+
+    if (node->shouldLoad()) {
+        log::debug("Load");
+        auto begin = std::chrono::high_resolution_clock::now();
+        auto res = node->m_impl->loadBinary();
+        m_binaryLoadTime += std::chrono::high_resolution_clock::now() - begin;
         if (!res) {
             this->addProblem({
-                LoadProblem::Type::UnzipFailed,
+                LoadProblem::Type::LoadFailed,
                 node,
                 res.unwrapErr()
             });
-            log::error("Failed to unzip: {}", res.unwrapErr());
-            m_refreshingModCount -= 1;
-            log::popNest();
-            return;
+            log::error("Failed to load binary: {}", res.unwrapErr());
         }
-        loadFunction();
     }
-    else {
+
+    log::popNest();
+}
+
+void Loader::Impl::startModUnzips() {
+    m_unzipBegin = std::chrono::high_resolution_clock::now();
+    m_unzipWorkTime = {};
+    m_unzipWallTime = {};
+    m_unzipResults.clear();
+    if (!m_workerPool) {
+        m_workerPool = std::make_unique<ThreadPool>("Mod Loader");
+    }
+
+    // late dependencies aren't enabled until loadModGraph gets to them, but
+    // m_modsToLoad is ordered so that they come before their dependants, so
+    // keep track of the ones that are going to be loaded
+    std::unordered_set<Mod*> willLoad;
+    auto willBeResolved = [&](ModMetadata::Dependency const& dep) {
+        if (dep.importance != ModMetadata::Dependency::Importance::Required) {
+            return true;
+        }
+        return dep.mod && (dep.mod->isEnabled() || willLoad.contains(dep.mod)) &&
+            dep.version.compare(dep.mod->getVersion());
+    };
+
+    for (auto node : m_modsToLoad) {
+        // these are going to be rejected by loadModGraph anyway
+        auto const& metadata = node->getMetadata();
+        auto deps = metadata.getDependencies();
+        if (
+            !std::all_of(deps.begin(), deps.end(), willBeResolved) ||
+            node->hasUnresolvedIncompatibilities() ||
+            metadata.m_impl->m_softInvalidReason ||
+            !metadata.checkGameVersion() ||
+            !this->isModVersionSupported(metadata.getGeodeVersion())
+        ) {
+            continue;
+        }
+        if (node->shouldLoad()) {
+            willLoad.insert(node);
+        }
+
+        m_pendingUnzipCount += 1;
         auto nest = log::saveNest();
-        std::thread([=, this]() {
-            thread::setName("Mod Unzip");
+        m_workerPool->push([this, node, nest, metadata]() {
             log::loadNest(nest);
-            auto res = unzipFunction();
-            this->queueInMainThread([=, this]() {
-                auto prevNest = log::saveNest();
-                log::loadNest(nest);
-                if (!res) {
-                    this->addProblem({
-                        LoadProblem::Type::UnzipFailed,
-                        node,
-                        res.unwrapErr()
-                    });
-                    log::error("Failed to unzip: {}", res.unwrapErr());
-                    m_refreshingModCount -= 1;
-                    log::loadNest(prevNest);
-                    return;
+            auto begin = std::chrono::high_resolution_clock::now();
+            log::debug("Unzipping {}", metadata.getID());
+            auto res = node->m_impl->unzipGeodeFile(metadata);
+            auto took = std::chrono::high_resolution_clock::now() - begin;
+            this->queueInMainThread([this, node, took, res = std::move(res)]() mutable {
+                m_unzipResults.insert({ node, std::move(res) });
+                m_unzipWorkTime += took;
+                m_pendingUnzipCount -= 1;
+                if (m_pendingUnzipCount == 0) {
+                    m_unzipWallTime = std::chrono::high_resolution_clock::now() - m_unzipBegin;
                 }
-                loadFunction();
-                log::loadNest(prevNest);
             });
-        }).detach();
+        });
     }
-    log::popNest();
+
+    log::debug(
+        "Unzipping {} mods on {} threads",
+        m_pendingUnzipCount, m_workerPool->getThreadCount()
+    );
 }
 
 void Loader::Impl::findProblems() {
@@ -668,6 +822,12 @@ void Loader::Impl::refreshModGraph() {
     }
 
     auto begin = std::chrono::high_resolution_clock::now();
+    auto phaseBegin = begin;
+    auto logPhaseTime = [&]() {
+        auto now = std::chrono::high_resolution_clock::now();
+        log::debug("Took {}ms", std::chrono::duration_cast<std::chrono::milliseconds>(now - phaseBegin).count());
+        phaseBegin = now;
+    };
 
     m_problems.clear();
 
@@ -676,6 +836,7 @@ void Loader::Impl::refreshModGraph() {
     log::pushNest();
     std::vector<ModMetadata> modQueue;
     this->queueMods(modQueue);
+    logPhaseTime();
     log::popNest();
 
     m_loadingState = LoadingState::List;
@@ -683,17 +844,20 @@ void Loader::Impl::refreshModGraph() {
     log::pushNest();
     this->populateModList(modQueue);
     modQueue.clear();
+    logPhaseTime();
     log::popNest();
 
     m_loadingState = LoadingState::Graph;
     log::debug("Building mod graph");
     log::pushNest();
     this->buildModGraph();
+    logPhaseTime();
     log::popNest();
 
     log::debug("Ordering mod stack");
     log::pushNest();
     this->orderModStack();
+    logPhaseTime();
     log::popNest();
 
     m_loadingState = LoadingState::EarlyMods;
@@ -704,6 +868,12 @@ void Loader::Impl::refreshModGraph() {
         m_modsToLoad.pop_front();
         this->loadModGraph(mod, true);
     }
+    logPhaseTime();
+    log::popNest();
+
+    log::debug("Unzipping mods");
+    log::pushNest();
+    this->startModUnzips();
     log::popNest();
 
     auto end = std::chrono::high_resolution_clock::now();
@@ -767,38 +937,61 @@ void Loader::Impl::orderModStack() {
 }
 
 void Loader::Impl::continueRefreshModGraph() {
-    if (m_refreshingModCount != 0) {
-        queueInMainThread([&]() {
-            this->continueRefreshModGraph();
-        });
-        return;
-    }
-
-    if  (m_lateRefreshedModCount > 0) {
-        auto end = std::chrono::high_resolution_clock::now();
-        auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - m_timerBegin).count();
-        log::info("Took {}s", static_cast<float>(time) / 1000.f);
-    }
-
-    log::info("Continuing mod graph refresh...");
-    log::pushNest();
-
-    m_timerBegin = std::chrono::high_resolution_clock::now();
+    // give the loading screen a chance to update every so often
+    constexpr auto FRAME_BUDGET = std::chrono::milliseconds(16);
+    auto frameBegin = std::chrono::high_resolution_clock::now();
 
     switch (m_loadingState) {
         case LoadingState::Mods:
             if (!m_modsToLoad.empty()) {
                 log::debug("Loading mods");
                 log::pushNest();
-                auto mod = m_modsToLoad.front();
-                m_modsToLoad.pop_front();
-                this->loadModGraph(mod, false);
+                // binaries have to be loaded in order, so stop at the first
+                // mod that is still being unzipped
+                while (
+                    !m_modsToLoad.empty() &&
+                    (m_unzipResults.contains(m_modsToLoad.front()) || m_pendingUnzipCount == 0) &&
+                    std::chrono::high_resolution_clock::now() - frameBegin < FRAME_BUDGET
+                ) {
+                    auto mod = m_modsToLoad.front();
+                    m_modsToLoad.pop_front();
+                    this->loadModGraph(mod, false);
+                }
                 log::popNest();
                 break;
             }
             m_loadingState = LoadingState::Problems;
             [[fallthrough]];
         case LoadingState::Problems:
+            {
+                auto toSeconds = [](auto duration) {
+                    return static_cast<float>(
+                        std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()
+                    ) / 1000.f;
+                };
+                log::info(
+                    "Loaded {} mods in {}s (unzip: {}s on {} threads, {}s total; binaries: {}s)",
+                    m_lateRefreshedModCount,
+                    toSeconds(std::chrono::high_resolution_clock::now() - m_unzipBegin),
+                    toSeconds(m_unzipWallTime),
+                    m_workerPool ? m_workerPool->getThreadCount() : 0,
+                    toSeconds(m_unzipWorkTime),
+                    toSeconds(m_binaryLoadTime)
+                );
+                // loading pushes a lot through the main thread queue, so
+                // this is when it's most likely to back up
+                auto queueStats = this->getMainThreadQueueStats();
+                log::info(
+                    "Main thread queue: up to {} functions waiting, longest drain {}ms",
+                    queueStats.maxDepth,
+                    static_cast<float>(queueStats.maxDrainTime.count()) / 1000.f
+                );
+            }
+            // every unzip has reported back by now, so the workers are idle
+            m_workerPool.reset();
+            m_unzipResults.clear();
+
+            m_timerBegin = std::chrono::high_resolution_clock::now();
             log::debug("Finding problems");
             log::pushNest();
             this->findProblems();
@@ -822,8 +1015,6 @@ void Loader::Impl::continueRefreshModGraph() {
             this->continueRefreshModGraph();
         });
     }
-
-    log::popNest();
 }
 
 std::vector<LoadProblem> Loader::Impl::getProblems() const {
@@ -850,35 +1041,111 @@ void Loader::Impl::addUninitializedHook(Hook* hook, Mod* mod) {
 
 bool Loader::Impl::loadHooks() {
     m_readyToHook = true;
-    bool hadErrors = false;
+    auto begin = std::chrono::high_resolution_clock::now();
+
+    // hooks are grouped by their target so every handler is only looked up
+    // once, and gets its detours added in priority order so tulip never has
+    // to move earlier detours around when a new one comes in
+    struct Target {
+        void* address;
+        std::vector<std::pair<Hook::Impl*, Mod*>> hooks;
+    };
+    std::vector<Target> targets;
+    std::unordered_map<void*, size_t> targetIndices;
+    size_t hookCount = 0;
     for (auto const& [hook, mod] : m_uninitializedHooks) {
-        auto res = hook->enable();
+        auto impl = hook->m_impl.get();
+        if (impl->m_enabled || impl->isPlaceholder()) {
+            continue;
+        }
+        auto [it, inserted] = targetIndices.try_emplace(impl->m_address, targets.size());
+        if (inserted) {
+            targets.push_back({ impl->m_address, {} });
+        }
+        targets[it->second].hooks.emplace_back(impl, mod);
+        hookCount += 1;
+    }
+    m_uninitializedHooks.clear();
+
+    bool hadErrors = false;
+    for (auto& target : targets) {
+        // every hook on a target shares the same handler metadata
+        auto res = this->getOrCreateHandler(target.address, target.hooks.front().first->m_handlerMetadata);
         if (!res) {
-            log::logImpl(Severity::Error, mod, "{}", res.unwrapErr());
+            // none of the hooks on this target get enabled
+            for (auto const& [hook, mod] : target.hooks) {
+                log::logImpl(Severity::Error, mod, "{}", res.unwrapErr());
+            }
             hadErrors = true;
+            continue;
+        }
+        auto handler = res.unwrap();
+
+        std::stable_sort(target.hooks.begin(), target.hooks.end(), [](auto const& a, auto const& b) {
+            return a.first->getPriority() < b.first->getPriority();
+        });
+        for (auto const& [hook, mod] : target.hooks) {
+            hook->enableWithHandler(handler);
         }
+        log::debug(
+            "Enabled {} hook{} at {}", target.hooks.size(),
+            target.hooks.size() == 1 ? "" : "s", target.address
+        );
     }
-    m_uninitializedHooks.clear();
+
+    auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - begin
+    ).count();
+    log::info("Enabled {} hooks on {} functions in {}ms", hookCount, targets.size(), time);
     return !hadErrors;
 }
 
 void Loader::Impl::queueInMainThread(ScheduledFunction&& func) {
     std::lock_guard<std::mutex> lock(m_mainThreadMutex);
-    m_mainThreadQueue.push_back(std::forward<ScheduledFunction>(func));
+    m_mainThreadQueue.push_back(std::move(func));
 }
 
 void Loader::Impl::executeMainThreadQueue() {
-    // copy queue to avoid locking mutex if someone is
-    // running addToMainThread inside their function
-    m_mainThreadMutex.lock();
-    auto queue = m_mainThreadQueue;
-    m_mainThreadQueue.clear();
-    m_mainThreadMutex.unlock();
-
-    // call queue
-    for (auto const& func : queue) {
+    auto begin = std::chrono::high_resolution_clock::now();
+
+    // only take new functions once everything left over from the last frame
+    // has been run, to keep them in order
+    if (m_mainThreadQueueIndex >= m_mainThreadQueueBack.size()) {
+        // clearing keeps the capacity, so after a couple of frames this
+        // doesn't allocate anymore
+        m_mainThreadQueueBack.clear();
+        m_mainThreadQueueIndex = 0;
+        std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+        std::swap(m_mainThreadQueue, m_mainThreadQueueBack);
+    }
+
+    auto& stats = m_mainThreadQueueStats;
+    stats.depth = m_mainThreadQueueBack.size() - m_mainThreadQueueIndex;
+    stats.maxDepth = std::max(stats.maxDepth, stats.depth);
+
+    // the lock isn't held here, so the functions are free to queue more
+    while (m_mainThreadQueueIndex < m_mainThreadQueueBack.size()) {
+        auto func = std::move(m_mainThreadQueueBack[m_mainThreadQueueIndex]);
+        m_mainThreadQueueIndex += 1;
         func();
+
+        if (
+            m_mainThreadQueueBudget.count() > 0 &&
+            std::chrono::high_resolution_clock::now() - begin >= m_mainThreadQueueBudget
+        ) {
+            break;
+        }
     }
+
+    stats.deferred = m_mainThreadQueueBack.size() - m_mainThreadQueueIndex;
+    stats.drainTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - begin
+    );
+    stats.maxDrainTime = std::max(stats.maxDrainTime, stats.drainTime);
+}
+
+MainThreadQueueStats Loader::Impl::getMainThreadQueueStats() const {
+    return m_mainThreadQueueStats;
 }
 
 void Loader::Impl::provideNextMod(Mod* mod) {
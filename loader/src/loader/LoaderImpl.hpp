@@ -1,6 +1,7 @@
 #pragma once
 
 #include "FileWatcher.hpp"
+#include "ThreadPool.hpp"
 
 #include <matjson.hpp>
 #include <Geode/loader/Dirs.hpp>
@@ -25,6 +26,17 @@
 namespace geode {
     static constexpr std::string_view LAUNCH_ARG_PREFIX = "--geode:";
 
+    struct MainThreadQueueStats {
+        // number of functions that were waiting when the queue was last run
+        size_t depth = 0;
+        size_t maxDepth = 0;
+        // number of functions that were deferred to the next frame due to
+        // the time budget running out
+        size_t deferred = 0;
+        std::chrono::microseconds drainTime {};
+        std::chrono::microseconds maxDrainTime {};
+    };
+
     class Loader::Impl {
     public:
         mutable std::mutex m_mutex;
@@ -41,8 +53,16 @@ namespace geode {
 
         LoadingState m_loadingState = LoadingState::None;
 
+        // functions are queued into m_mainThreadQueue and then swapped into
+        // m_mainThreadQueueBack for running, so neither buffer has to be
+        // copied or reallocated every frame
         std::vector<utils::MiniFunction<void(void)>> m_mainThreadQueue;
+        std::vector<utils::MiniFunction<void(void)>> m_mainThreadQueueBack;
+        size_t m_mainThreadQueueIndex = 0;
         mutable std::mutex m_mainThreadMutex;
+        // zero means no limit; set with --geode:main-thread-queue-budget=<ms>
+        std::chrono::microseconds m_mainThreadQueueBudget {};
+        MainThreadQueueStats m_mainThreadQueueStats;
         std::vector<std::pair<Hook*, Mod*>> m_uninitializedHooks;
         bool m_readyToHook = false;
 
@@ -54,13 +74,22 @@ namespace geode {
 
         Mod* m_currentlyLoadingMod = nullptr;
 
-        int m_refreshingModCount = 0;
         int m_refreshedModCount = 0;
         int m_lateRefreshedModCount = 0;
 
+        // used for scanning packages and unzipping non-early mods up front;
+        // binaries are still loaded one by one in order on the main thread
+        std::unique_ptr<ThreadPool> m_workerPool;
+        std::unordered_map<Mod*, Result<>> m_unzipResults;
+        size_t m_pendingUnzipCount = 0;
+
         std::unordered_map<std::string, std::string> m_launchArgs;
 
         std::chrono::time_point<std::chrono::high_resolution_clock> m_timerBegin;
+        std::chrono::time_point<std::chrono::high_resolution_clock> m_unzipBegin;
+        std::chrono::high_resolution_clock::duration m_unzipWorkTime {};
+        std::chrono::high_resolution_clock::duration m_unzipWallTime {};
+        std::chrono::high_resolution_clock::duration m_binaryLoadTime {};
 
         std::string getGameVersion();
         bool isForwardCompatMode();
@@ -101,6 +130,7 @@ namespace geode {
         void buildModGraph();
         void orderModStack();
         void loadModGraph(Mod* node, bool early);
+        void startModUnzips();
         void findProblems();
         void refreshModGraph();
         void continueRefreshModGraph();
@@ -124,6 +154,7 @@ namespace geode {
 
         void queueInMainThread(ScheduledFunction&& func);
         void executeMainThreadQueue();
+        MainThreadQueueStats getMainThreadQueueStats() const;
 
         bool isReadyToHook() const;
         void addUninitializedHook(Hook* hook, Mod* mod);
@@ -139,6 +170,10 @@ namespace geode {
         bool isSafeMode() const;
         // enables safe mode, even if the launch arg wasnt provided
         void forceSafeMode();
+
+        // identifies a specific revision of a file by its size and last
+        // write time; empty if the file can't be read
+        static std::string getFileStamp(std::filesystem::path const& path);
     };
 
     class LoaderImpl : public Loader::Impl {
@@ -1,5 +1,7 @@
 #include "console.hpp"
+#include "BinaryLog.hpp"
 #include "LogImpl.hpp"
+#include "../utils/thread.hpp"
 
 #include <Geode/loader/Dirs.hpp>
 #include <Geode/loader/Log.hpp>
@@ -8,6 +10,7 @@
 #include <Geode/utils/general.hpp>
 #include <fmt/chrono.h>
 #include <fmt/format.h>
+#include <algorithm>
 #include <iomanip>
 #include <memory>
 #include <utility>
@@ -94,27 +97,31 @@ std::string cocos2d::format_as(cocos2d::ccColor4B const& col) {
 inline static thread_local int32_t s_nestLevel = 0;
 inline static thread_local int32_t s_nestCountOffset = 0;
 
+bool log::isEnabled(Severity sev, Mod* mod) {
+    return mod->isLoggingEnabled() && sev.m_value >= mod->getLogLevel().m_value;
+}
+
 void log::vlogImpl(Severity sev, Mod* mod, fmt::string_view format, fmt::format_args args) {
-    if (!mod->isLoggingEnabled()) return;
+    if (!log::isEnabled(sev, mod)) return;
 
     auto nestCount = s_nestLevel * 2;
     if (nestCount != 0) {
         nestCount += s_nestCountOffset;
     }
 
-    Logger::get()->push(sev, thread::getName(), mod->getName(), nestCount,
-        fmt::vformat(format, args));
+    Logger::get()->push(sev, thread::getSharedName(), mod, nestCount, fmt::vformat(format, args));
 }
 
 
-Log::Log(Severity sev, std::string&& thread, std::string&& source, int32_t nestCount,
-    std::string&& content) :
-    m_time(log_clock::now()),
+Log::Log(log_clock::time_point time, Severity sev, std::string&& thread, std::string&& source,
+    int32_t nestCount, std::string&& content, Mod* mod) :
+    m_time(time),
     m_severity(sev),
     m_thread(thread),
     m_source(source),
     m_nestCount(nestCount),
-    m_content(content) {}
+    m_content(content),
+    m_mod(mod) {}
 
 Log::~Log() = default;
 
@@ -204,44 +211,275 @@ Severity Log::getSeverity() const {
     return m_severity;
 }
 
+log_clock::time_point Log::getTime() const {
+    return m_time;
+}
+
+std::string const& Log::getThread() const {
+    return m_thread;
+}
+
+std::string const& Log::getSource() const {
+    return m_source;
+}
+
+int32_t Log::getNestCount() const {
+    return m_nestCount;
+}
+
+std::string const& Log::getContent() const {
+    return m_content;
+}
+
+Mod* Log::getMod() const {
+    return m_mod;
+}
+
 // Logger
 
+struct Logger::QueuedLog final {
+    log_clock::time_point time;
+    Severity severity;
+    std::shared_ptr<std::string const> thread;
+    // mods are never destroyed, so the name can be looked up by the writer;
+    // null for logs that aren't from a mod, which have their source instead
+    Mod* mod;
+    std::string source;
+    int32_t nestCount;
+    std::string content;
+    QueuedLog* next = nullptr;
+};
+
 Logger* Logger::get() {
-    static Logger inst;
-    return &inst;
+    // never destroyed, since the writer thread may still be running at exit
+    static auto inst = new Logger();
+    return inst;
 }
 
 void Logger::setup() {
-    m_logStream = std::ofstream(dirs::getGeodeLogDir() / log::generateLogName());
+    m_logPath = dirs::getGeodeLogDir() / log::generateLogName();
+    m_logStream = std::ofstream(m_logPath);
+
+    std::thread([this] {
+        thread::setName("Log Writer");
+        this->writeLoop();
+    }).detach();
+    std::atexit([] {
+        Logger::get()->flush();
+    });
 }
 
-std::mutex& getLogMutex() {
-    static std::mutex mutex;
-    return mutex;
+void Logger::push(Severity sev, std::shared_ptr<std::string const> thread, Mod* mod,
+    int32_t nestCount, std::string&& content) {
+    this->enqueue(new QueuedLog {
+        log_clock::now(), sev, std::move(thread), mod, "", nestCount, std::move(content)
+    });
 }
 
 void Logger::push(Severity sev, std::string&& thread, std::string&& source, int32_t nestCount,
     std::string&& content) {
-    std::lock_guard g(getLogMutex());
+    this->enqueue(new QueuedLog {
+        log_clock::now(), sev,
+        thread.empty() ? nullptr : std::make_shared<std::string const>(std::move(thread)),
+        nullptr, std::move(source), nestCount, std::move(content)
+    });
+}
 
-    Log& log = m_logs.emplace_back(sev, std::move(thread), std::move(source), nestCount,
-            std::move(content));
+void Logger::enqueue(QueuedLog* queued) {
+    if (!m_async) {
+        std::unique_lock lock(m_writeMutex);
+        // same as the writer thread, so flush knows not to wait on itself if
+        // this thread crashes while writing
+        m_writingThread = std::this_thread::get_id();
+        // anything still queued from before has to come first
+        this->writeQueued();
+        std::vector<Log> batch;
+        batch.push_back(this->toLog(std::move(*queued)));
+        delete queued;
+        this->write(std::move(batch));
+        m_writingThread = std::thread::id();
+        return;
+    }
+
+    auto head = m_queue.load(std::memory_order_relaxed);
+    do {
+        queued->next = head;
+    } while (!m_queue.compare_exchange_weak(
+        head, queued, std::memory_order_release, std::memory_order_relaxed
+    ));
+    // the writer only needs waking up if it might've gone to sleep
+    if (!head) {
+        m_wake.notify_one();
+    }
+}
+
+void Logger::writeLoop() {
+    while (true) {
+        {
+            // producers notify without taking the lock, so a wakeup can be
+            // missed; the timeout makes sure those logs still get written
+            std::unique_lock lock(m_wakeMutex);
+            m_wake.wait_for(lock, std::chrono::milliseconds(100), [this] {
+                return m_queue.load(std::memory_order_relaxed) != nullptr;
+            });
+        }
+        std::unique_lock lock(m_writeMutex);
+        m_writingThread = std::this_thread::get_id();
+        this->writeQueued();
+        m_writingThread = std::thread::id();
+    }
+}
+
+void Logger::writeQueued() {
+    auto queued = m_queue.exchange(nullptr, std::memory_order_acquire);
+    if (!queued) {
+        return;
+    }
+    std::vector<Log> batch;
+    while (queued) {
+        batch.push_back(this->toLog(std::move(*queued)));
+        delete std::exchange(queued, queued->next);
+    }
+    // the queue is newest first
+    std::reverse(batch.begin(), batch.end());
+    this->write(std::move(batch));
+}
+
+Logger::ModNames const& Logger::getModNames(Mod* mod) {
+    auto it = m_modNames.find(mod);
+    if (it == m_modNames.end()) {
+        it = m_modNames.insert({ mod, ModNames { mod->getName(), mod->getID() } }).first;
+    }
+    return it->second;
+}
 
-    auto const logStr = log.toString();
-    console::log(logStr, log.getSeverity());
-    m_logStream << logStr << std::endl;
+Log Logger::toLog(QueuedLog&& queued) {
+    auto source = queued.mod ? this->getModNames(queued.mod).name : std::move(queued.source);
+    return Log(
+        queued.time, queued.severity, queued.thread ? std::string(*queued.thread) : std::string(),
+        std::move(source), queued.nestCount, std::move(queued.content), queued.mod
+    );
+}
+
+uint32_t Logger::internBinaryString(std::string& out, std::string const& str) {
+    auto [it, inserted] = m_binaryStrings.try_emplace(str, static_cast<uint32_t>(m_binaryStrings.size()));
+    if (inserted) {
+        binary::write(out, binary::RecordType::String);
+        binary::write(out, it->second);
+        binary::write(out, str);
+    }
+    return it->second;
+}
+
+void Logger::write(std::vector<Log>&& batch) {
+    // with only the binary log to write to, the text version isn't needed
+    bool const isBinary = m_binaryStream.is_open();
+    bool const needsText = !isBinary || console::isOpen();
+
+    std::string out;
+    for (auto const& log : batch) {
+        std::string logStr;
+        if (needsText) {
+            logStr = log.toString();
+            console::log(logStr, log.getSeverity());
+        }
+        if (isBinary) {
+            auto source = this->internBinaryString(out, log.getSource());
+            auto thread = this->internBinaryString(out, log.getThread());
+            static std::string const noMod;
+            auto modID = this->internBinaryString(
+                out, log.getMod() ? this->getModNames(log.getMod()).id : noMod
+            );
+            binary::write(out, binary::RecordType::Log);
+            binary::write(out, static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                log.getTime().time_since_epoch()
+            ).count()));
+            binary::write(out, static_cast<uint8_t>(log.getSeverity().m_value));
+            binary::write(out, source);
+            binary::write(out, thread);
+            binary::write(out, log.getNestCount());
+            binary::write(out, log.getContent());
+            binary::write(out, modID);
+        }
+        else {
+            out += logStr;
+            out += '\n';
+        }
+    }
+    // one write and flush for the whole batch
+    if (isBinary) {
+        m_binaryStream << out << std::flush;
+    }
+    else {
+        m_logStream << out << std::flush;
+    }
+
+    std::unique_lock lock(m_historyMutex);
+    for (auto& log : batch) {
+        m_logs.push_back(std::move(log));
+    }
+    while (m_logs.size() > m_historyLimit) {
+        m_logs.pop_front();
+    }
+}
+
+void Logger::flush() {
+    // if we crashed while writing, the writer is never going to finish
+    if (m_writingThread == std::this_thread::get_id()) {
+        return;
+    }
+    std::unique_lock lock(m_writeMutex, std::defer_lock);
+    if (!lock.try_lock_for(std::chrono::seconds(1))) {
+        return;
+    }
+    this->writeQueued();
+}
+
+void Logger::setAsync(bool async) {
+    m_async = async;
+    if (!async) {
+        this->flush();
+    }
+}
+
+void Logger::enableBinaryOutput() {
+    std::unique_lock lock(m_writeMutex);
+    if (m_binaryStream.is_open()) {
+        return;
+    }
+    // whatever was pushed before this still goes into the text log
+    this->writeQueued();
+
+    auto path = m_logPath;
+    path.replace_extension(binary::FILE_EXTENSION);
+    m_binaryStream = std::ofstream(path, std::ios::binary);
+    if (!m_binaryStream) {
+        return;
+    }
+    m_binaryStream << binary::header() << std::flush;
+    m_logStream << "Continuing in binary log " << path.filename().string() << std::endl;
+    m_logStream.close();
+}
+
+void Logger::setHistoryLimit(size_t limit) {
+    std::unique_lock lock(m_historyMutex);
+    m_historyLimit = limit;
+    while (m_logs.size() > m_historyLimit) {
+        m_logs.pop_front();
+    }
 }
 
 Nest::Nest(std::shared_ptr<Nest::Impl> impl) : m_impl(std::move(impl)) { }
 Nest::Impl::Impl(int32_t nestLevel, int32_t nestCountOffset) :
     m_nestLevel(nestLevel), m_nestCountOffset(nestCountOffset) { }
 
-std::vector<Log> const& Logger::list() {
-    return m_logs;
+std::vector<Log> Logger::list() {
+    std::unique_lock lock(m_historyMutex);
+    return std::vector<Log>(m_logs.begin(), m_logs.end());
 }
 
 void Logger::clear() {
-    std::lock_guard g(getLogMutex());
+    std::unique_lock lock(m_historyMutex);
     m_logs.clear();
 }
 
@@ -3,9 +3,15 @@
 #include <Geode/DefaultInclude.hpp>
 #include <Geode/loader/Log.hpp>
 #include <Geode/loader/Mod.hpp>
-#include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace geode::log {
     class Log final {
@@ -15,32 +21,111 @@ namespace geode::log {
         std::string m_source;
         int32_t m_nestCount;
         std::string m_content;
+        Mod* m_mod;
 
     public:
         ~Log();
-        Log(Severity sev, std::string&& thread, std::string&& source, int32_t nestCount,
-            std::string&& content);
+        Log(log_clock::time_point time, Severity sev, std::string&& thread, std::string&& source,
+            int32_t nestCount, std::string&& content, Mod* mod = nullptr);
+        Log(Log const&) = default;
+        Log(Log&&) = default;
+        Log& operator=(Log const&) = default;
+        Log& operator=(Log&&) = default;
 
         [[nodiscard]] std::string toString() const;
 
         [[nodiscard]] Severity getSeverity() const;
+        [[nodiscard]] log_clock::time_point getTime() const;
+        [[nodiscard]] std::string const& getThread() const;
+        [[nodiscard]] std::string const& getSource() const;
+        [[nodiscard]] int32_t getNestCount() const;
+        [[nodiscard]] std::string const& getContent() const;
+        // null if the log didn't come from a mod
+        [[nodiscard]] Mod* getMod() const;
     };
 
     class Logger {
     private:
-        std::vector<Log> m_logs;
+        struct QueuedLog;
+        struct ModNames final {
+            std::string name;
+            std::string id;
+        };
+
+        // the most recent logs, oldest first
+        std::deque<Log> m_logs;
+        size_t m_historyLimit = DEFAULT_HISTORY_LIMIT;
+        std::mutex m_historyMutex;
+
+        std::filesystem::path m_logPath;
         std::ofstream m_logStream;
+        // only open if binary output is enabled, in which case the text log
+        // isn't written to anymore
+        std::ofstream m_binaryStream;
+        std::unordered_map<std::string, uint32_t> m_binaryStrings;
+        // names of the mods that have logged something, only used while
+        // holding the write mutex
+        std::unordered_map<Mod*, ModNames> m_modNames;
+        // held while a batch is being written out
+        std::timed_mutex m_writeMutex;
+        std::atomic<std::thread::id> m_writingThread;
+
+        // logs waiting for the writer thread, newest first
+        std::atomic<QueuedLog*> m_queue = nullptr;
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wake;
+        std::atomic_bool m_async = true;
 
         Logger() = default;
+
+        void enqueue(QueuedLog* queued);
+        ModNames const& getModNames(Mod* mod);
+        Log toLog(QueuedLog&& queued);
+        void writeLoop();
+        void writeQueued();
+        void write(std::vector<Log>&& batch);
+        uint32_t internBinaryString(std::string& out, std::string const& str);
+
     public:
+        static constexpr size_t DEFAULT_HISTORY_LIMIT = 10000;
+
         static Logger* get();
 
         void setup();
 
+        /**
+         * Queue a log from a mod. The thread and mod names are only copied
+         * into the log once the writer gets to it, so logging doesn't
+         * allocate anything but the message
+         */
+        void push(Severity sev, std::shared_ptr<std::string const> thread, Mod* mod,
+            int32_t nestCount, std::string&& content);
         void push(Severity sev, std::string&& thread, std::string&& source, int32_t nestCount,
             std::string&& content);
 
-        std::vector<Log> const& list();
+        /**
+         * Write out everything that's been pushed so far. Safe to call
+         * from crash handlers; gives up if the writer is stuck
+         */
+        void flush();
+
+        /**
+         * In async mode (the default) logs are queued and written out in
+         * batches by a background thread; otherwise every log is written
+         * and flushed to the file before push returns
+         */
+        void setAsync(bool async);
+        /**
+         * Set how many of the most recent logs are kept in memory
+         */
+        void setHistoryLimit(size_t limit);
+        /**
+         * Switch the log file over to the compact binary format from
+         * BinaryLog.hpp, which can be turned back into text with logconv
+         */
+        void enableBinaryOutput();
+
+        std::vector<Log> list();
         void clear();
     };
 
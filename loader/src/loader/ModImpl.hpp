@@ -64,6 +64,7 @@ namespace geode {
          * Whether logging is enabled for this mod
          */
         bool m_loggingEnabled = true;
+        Severity m_logLevel = Severity::Debug;
 
         std::unordered_map<std::string, char const*> m_expandedSprites;
 
@@ -152,6 +153,8 @@ namespace geode {
 
         bool isLoggingEnabled() const;
         void setLoggingEnabled(bool enabled);
+        Severity getLogLevel() const;
+        void setLogLevel(Severity level);
 
         std::vector<LoadProblem> getProblems() const;
 
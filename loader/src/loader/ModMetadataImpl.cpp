@@ -8,6 +8,7 @@
 #include <matjson.hpp>
 #include <utility>
 #include <clocale>
+#include <mutex>
 
 #include "ModMetadataImpl.hpp"
 #include "LoaderImpl.hpp"
@@ -369,12 +370,12 @@ Result<ModMetadata> ModMetadata::Impl::createFromFile(std::filesystem::path cons
     return Ok(info);
 }
 
-Result<ModMetadata> ModMetadata::Impl::createFromGeodeFile(std::filesystem::path const& path) {
+Result<ModMetadata> ModMetadata::Impl::createFromGeodeFile(std::filesystem::path const& path, bool loadSpecialFiles) {
     GEODE_UNWRAP_INTO(auto unzip, file::Unzip::create(path));
-    return ModMetadata::createFromGeodeZip(unzip);
+    return Impl::createFromGeodeZip(unzip, loadSpecialFiles);
 }
 
-Result<ModMetadata> ModMetadata::Impl::createFromGeodeZip(file::Unzip& unzip) {
+Result<ModMetadata> ModMetadata::Impl::createFromGeodeZip(file::Unzip& unzip, bool loadSpecialFiles) {
     // Check if mod.json exists in zip
     if (!unzip.hasEntry("mod.json")) {
         return Err("\"" + unzip.getPath().string() + "\" is missing mod.json");
@@ -400,19 +401,44 @@ Result<ModMetadata> ModMetadata::Impl::createFromGeodeZip(file::Unzip& unzip) {
     auto impl = info.m_impl.get();
     impl->m_path = unzip.getPath();
 
-    GEODE_UNWRAP(info.addSpecialFiles(unzip).expect("Unable to add extra files: {error}"));
+    if (loadSpecialFiles) {
+        GEODE_UNWRAP(info.addSpecialFiles(unzip).expect("Unable to add extra files: {error}"));
+    }
+    else {
+        impl->m_specialFilesPending = true;
+    }
+
+    return Ok(info);
+}
 
+Result<ModMetadata> ModMetadata::Impl::createFromIndex(std::filesystem::path const& path, ModJson const& json) {
+    // the index stores the raw mod.json of an unchanged .geode file, so this
+    // is the same as createFromGeodeFile minus opening the zip
+    auto res = ModMetadata::create(json);
+    if (!res) {
+        return Err("\"" + path.string() + "\" - " + res.unwrapErr());
+    }
+    auto info = res.unwrap();
+    auto impl = info.m_impl.get();
+    impl->m_path = path;
+    impl->m_specialFilesPending = true;
     return Ok(info);
 }
 
 Result<> ModMetadata::Impl::addSpecialFiles(file::Unzip& unzip) {
     // unzip known MD files
+    std::vector<std::filesystem::path> files;
+    std::vector<std::optional<std::string>*> targets;
     for (auto& [file, target] : this->getSpecialFiles()) {
         if (unzip.hasEntry(file)) {
-            GEODE_UNWRAP_INTO(auto data, unzip.extract(file).expect("Unable to extract \"{}\"", file));
-            *target = sanitizeDetailsData(std::string(data.begin(), data.end()));
+            files.push_back(file);
+            targets.push_back(target);
         }
     }
+    GEODE_UNWRAP_INTO(auto datas, unzip.extractMany(files).expect("Unable to extract special files: {error}"));
+    for (size_t i = 0; i < datas.size(); i += 1) {
+        *targets[i] = sanitizeDetailsData(std::string(datas[i].begin(), datas[i].end()));
+    }
     return Ok();
 }
 
@@ -430,6 +456,32 @@ Result<> ModMetadata::Impl::addSpecialFiles(std::filesystem::path const& dir) {
     return Ok();
 }
 
+void ModMetadata::Impl::loadSpecialFiles() {
+    // this is called from const getters, which may run on any thread
+    static std::mutex mutex;
+    std::lock_guard lock(mutex);
+
+    if (!m_specialFilesPending) {
+        return;
+    }
+    m_specialFilesPending = false;
+
+    if (!m_packageStamp.empty() && Loader::Impl::getFileStamp(m_path) != m_packageStamp) {
+        log::warn("\"{}\" has changed since it was loaded, not reading its extra files", m_path);
+        return;
+    }
+
+    auto unzip = file::Unzip::create(m_path);
+    if (!unzip) {
+        log::warn("Unable to open \"{}\" for extra files: {}", m_path, unzip.unwrapErr());
+        return;
+    }
+    auto res = this->addSpecialFiles(unzip.unwrap());
+    if (!res) {
+        log::warn("Unable to add extra files for {}: {}", m_id, res.unwrapErr());
+    }
+}
+
 std::vector<std::pair<std::string, std::optional<std::string>*>> ModMetadata::Impl::getSpecialFiles() {
     return {
         {"about.md", &this->m_details},
@@ -502,12 +554,15 @@ std::optional<std::string> ModMetadata::getDescription() const {
     return m_impl->m_description;
 }
 std::optional<std::string> ModMetadata::getDetails() const {
+    m_impl->loadSpecialFiles();
     return m_impl->m_details;
 }
 std::optional<std::string> ModMetadata::getChangelog() const {
+    m_impl->loadSpecialFiles();
     return m_impl->m_changelog;
 }
 std::optional<std::string> ModMetadata::getSupportInfo() const {
+    m_impl->loadSpecialFiles();
     return m_impl->m_supportInfo;
 }
 std::optional<std::string> ModMetadata::getRepository() const {
@@ -618,12 +673,15 @@ void ModMetadata::setDescription(std::optional<std::string> const& value) {
     m_impl->m_description = value;
 }
 void ModMetadata::setDetails(std::optional<std::string> const& value) {
+    m_impl->loadSpecialFiles();
     m_impl->m_details = value;
 }
 void ModMetadata::setChangelog(std::optional<std::string> const& value) {
+    m_impl->loadSpecialFiles();
     m_impl->m_changelog = value;
 }
 void ModMetadata::setSupportInfo(std::optional<std::string> const& value) {
+    m_impl->loadSpecialFiles();
     m_impl->m_supportInfo = value;
 }
 void ModMetadata::setRepository(std::optional<std::string> const& value) {
@@ -708,6 +766,7 @@ Result<> ModMetadata::addSpecialFiles(utils::file::Unzip& zip) {
 }
 
 std::vector<std::pair<std::string, std::optional<std::string>*>> ModMetadata::getSpecialFiles() {
+    m_impl->loadSpecialFiles();
     return m_impl->getSpecialFiles();
 }
 
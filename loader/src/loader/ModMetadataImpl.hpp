@@ -32,6 +32,12 @@ namespace geode {
         std::optional<std::string> m_details;
         std::optional<std::string> m_changelog;
         std::optional<std::string> m_supportInfo;
+        // about.md & co. of packages found by the loader are only read out
+        // of the .geode file once something asks for them, see loadSpecialFiles
+        bool m_specialFilesPending = false;
+        // stamp of the package when it was scanned, so extra files aren't
+        // read out of a package that has since been replaced
+        std::string m_packageStamp;
         ModMetadataLinks m_links;
         std::optional<IssuesInfo> m_issues;
         std::vector<Dependency> m_dependencies;
@@ -44,9 +50,10 @@ namespace geode {
 
         ModJson m_rawJSON;
 
-        static Result<ModMetadata> createFromGeodeZip(utils::file::Unzip& zip);
-        static Result<ModMetadata> createFromGeodeFile(std::filesystem::path const& path);
+        static Result<ModMetadata> createFromGeodeZip(utils::file::Unzip& zip, bool loadSpecialFiles = true);
+        static Result<ModMetadata> createFromGeodeFile(std::filesystem::path const& path, bool loadSpecialFiles = true);
         static Result<ModMetadata> createFromFile(std::filesystem::path const& path);
+        static Result<ModMetadata> createFromIndex(std::filesystem::path const& path, ModJson const& json);
         static Result<ModMetadata> create(ModJson const& json);
 
         ModJson toJSON() const;
@@ -62,6 +69,7 @@ namespace geode {
 
         Result<> addSpecialFiles(std::filesystem::path const& dir);
         Result<> addSpecialFiles(utils::file::Unzip& zip);
+        void loadSpecialFiles();
 
         std::vector<std::pair<std::string, std::optional<std::string>*>> getSpecialFiles();
     };
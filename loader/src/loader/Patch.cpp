@@ -26,6 +26,10 @@ Result<> Patch::disable() {
     return m_impl->disable();
 }
 
+Result<> Patch::enableAll(std::span<Patch* const> patches) {
+    return Impl::enableAll(patches);
+}
+
 bool Patch::getAutoEnable() const {
     return m_impl->getAutoEnable();
 }
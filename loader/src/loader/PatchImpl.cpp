@@ -1,5 +1,6 @@
 ﻿#include "PatchImpl.hpp"
 
+#include <algorithm>
 #include <utility>
 #include "LoaderImpl.hpp"
 
@@ -24,11 +25,8 @@ Patch::Impl::~Impl() {
 
 // TODO: replace this with a safe one
 static ByteVector readMemory(void* address, size_t amount) {
-    ByteVector ret;
-    for (size_t i = 0; i < amount; i++) {
-        ret.push_back(*reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(address) + i));
-    }
-    return ret;
+    auto start = reinterpret_cast<uint8_t const*>(address);
+    return ByteVector(start, start + amount);
 }
 
 std::shared_ptr<Patch> Patch::Impl::create(void* address, const geode::ByteVector& patch) {
@@ -40,44 +38,136 @@ std::shared_ptr<Patch> Patch::Impl::create(void* address, const geode::ByteVecto
     });
 }
 
-std::vector<Patch::Impl*>& Patch::Impl::allEnabled() {
-    static std::vector<Patch::Impl*> vec;
-    return vec;
+std::map<uintptr_t, Patch::Impl*>& Patch::Impl::allEnabled() {
+    static std::map<uintptr_t, Patch::Impl*> enabled;
+    return enabled;
 }
 
-Result<> Patch::Impl::enable() {
+Patch::Impl* Patch::Impl::findOverlapping() const {
     auto const thisMin = this->getAddress();
-    auto const thisMax = this->getAddress() + this->m_patch.size() - 1;
-    // TODO: this feels slow. can be faster
-    for (const auto& other : allEnabled()) {
-        auto const otherMin = other->getAddress();
-        auto const otherMax = other->getAddress() + other->m_patch.size() - 1;
-        bool intersects = (thisMin >= otherMin && thisMin <= otherMax) || (thisMax >= otherMin && thisMax <= otherMax);
-        if (!intersects)
-            continue;
+    auto const thisEnd = thisMin + m_patch.size();
+    auto& enabled = allEnabled();
+
+    // the first patch starting at or after this one
+    auto it = enabled.lower_bound(thisMin);
+    if (it != enabled.end() && it->second != this && it->first < thisEnd) {
+        return it->second;
+    }
+    // the last patch starting before this one
+    if (it != enabled.begin()) {
+        auto prev = std::prev(it);
+        if (prev->second != this && prev->first + prev->second->m_patch.size() > thisMin) {
+            return prev->second;
+        }
+    }
+    return nullptr;
+}
+
+std::string Patch::Impl::getOwnerID() const {
+    return m_owner ? m_owner->getID() : "<unowned>";
+}
+
+Result<> Patch::Impl::enable() {
+    if (auto other = this->findOverlapping()) {
         return Err(
             "Failed to enable patch: overlaps patch at {} from {}",
-            other->m_address, other->getOwner()->getID()
+            other->m_address, other->getOwnerID()
         );
     }
     auto res = tulip::hook::writeMemory(m_address, m_patch.data(), m_patch.size());
     if (!res) return Err("Failed to enable patch: {}", res.unwrapErr());
     m_enabled = true;
-    allEnabled().push_back(this);
+    allEnabled().insert({ this->getAddress(), this });
     return Ok();
 }
 
-Result<> Patch::Impl::disable() {
-    auto res = tulip::hook::writeMemory(m_address, m_original.data(), m_original.size());
-    if (!res) return Err("Failed to disable patch: {}", res.unwrapErr());
+Result<> Patch::Impl::enableAll(std::span<Patch* const> patches) {
+    std::vector<Patch::Impl*> sorted;
+    sorted.reserve(patches.size());
+    for (auto patch : patches) {
+        if (!patch->isEnabled()) {
+            sorted.push_back(patch->m_impl.get());
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) {
+        return a->getAddress() < b->getAddress();
+    });
 
-    m_enabled = false;
-    auto it = std::find(allEnabled().begin(), allEnabled().end(), this);
+    // check everything before writing anything
+    for (size_t i = 0; i < sorted.size(); i += 1) {
+        auto patch = sorted[i];
+        if (auto other = patch->findOverlapping()) {
+            return Err(
+                "Failed to enable patch at {}: overlaps patch at {} from {}",
+                patch->m_address, other->m_address, other->getOwnerID()
+            );
+        }
+        if (i > 0 && sorted[i - 1]->getAddress() + sorted[i - 1]->m_patch.size() > patch->getAddress()) {
+            return Err(
+                "Failed to enable patch at {}: overlaps patch at {} being enabled with it",
+                patch->m_address, sorted[i - 1]->m_address
+            );
+        }
+    }
+
+    // patches that directly follow each other are written together, so the 
+    // run only has its protection changed once. Patches with gaps between 
+    // them are written separately, since filling the gap would mean writing 
+    // over bytes that something else might be changing at the same time
+    struct Run {
+        uintptr_t start;
+        ByteVector original;
+    };
+    std::vector<Run> written;
+    auto rollback = [&] {
+        for (auto& run : written) {
+            (void)tulip::hook::writeMemory(
+                reinterpret_cast<void*>(run.start), run.original.data(), run.original.size()
+            );
+        }
+    };
+    for (size_t i = 0; i < sorted.size();) {
+        auto start = sorted[i]->getAddress();
+        auto end = start + sorted[i]->m_patch.size();
+        size_t runEnd = i + 1;
+        while (runEnd < sorted.size() && sorted[runEnd]->getAddress() == end) {
+            end = sorted[runEnd]->getAddress() + sorted[runEnd]->m_patch.size();
+            runEnd += 1;
+        }
+
+        auto original = readMemory(reinterpret_cast<void*>(start), end - start);
+        ByteVector bytes;
+        bytes.reserve(end - start);
+        for (size_t j = i; j < runEnd; j += 1) {
+            auto& patch = sorted[j]->m_patch;
+            bytes.insert(bytes.end(), patch.begin(), patch.end());
+        }
+        auto res = tulip::hook::writeMemory(reinterpret_cast<void*>(start), bytes.data(), bytes.size());
+        if (!res) {
+            rollback();
+            return Err("Failed to enable patch at {}: {}", sorted[i]->m_address, res.unwrapErr());
+        }
+        written.push_back({ start, std::move(original) });
+        i = runEnd;
+    }
 
-    if (it == allEnabled().end()) {
+    for (auto patch : sorted) {
+        patch->m_enabled = true;
+        allEnabled().insert({ patch->getAddress(), patch });
+    }
+    return Ok();
+}
+
+Result<> Patch::Impl::disable() {
+    auto it = allEnabled().find(this->getAddress());
+    if (it == allEnabled().end() || it->second != this) {
         return Err("Failed to disable patch: patch is already disabled");
     }
 
+    auto res = tulip::hook::writeMemory(m_address, m_original.data(), m_original.size());
+    if (!res) return Err("Failed to disable patch: {}", res.unwrapErr());
+
+    m_enabled = false;
     allEnabled().erase(it);
     return Ok();
 }
@@ -5,6 +5,8 @@
 #include <Geode/loader/Mod.hpp>
 #include "ModImpl.hpp"
 #include "ModPatch.hpp"
+#include <map>
+#include <span>
 
 using namespace geode::prelude;
 
@@ -14,7 +16,10 @@ public:
     ~Impl();
 
     static std::shared_ptr<Patch> create(void* address, const ByteVector& patch);
-    static std::vector<Patch::Impl*>& allEnabled();
+    // enabled patches by address; they never overlap, so only the patches
+    // right before and after an address need to be checked for overlaps
+    static std::map<uintptr_t, Patch::Impl*>& allEnabled();
+    static Result<> enableAll(std::span<Patch* const> patches);
 
     Patch* m_self = nullptr;
     void* m_address;
@@ -23,6 +28,9 @@ public:
 
     Result<> enable();
     Result<> disable();
+    // returns the enabled patch overlapping this one, if any
+    Patch::Impl* findOverlapping() const;
+    std::string getOwnerID() const;
 
     ByteVector const& getBytes() const;
     Result<> updateBytes(const ByteVector& bytes);
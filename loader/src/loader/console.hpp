@@ -13,6 +13,9 @@ namespace geode::console {
     // and attach it (perhaps, by calling setup again, see windows impl for an example)
     void openIfClosed();
 
+    // whether console::log prints anywhere; if not, logs don't need to be
+    // formatted as text for it
+    bool isOpen();
     void log(std::string const& msg, Severity severity);
     void messageBox(char const* title, std::string const& info, Severity severity = Severity::Error);
 }
@@ -5,6 +5,7 @@
 #include <utility>
 #include "LoaderImpl.hpp"
 #include "ModMetadataImpl.hpp"
+#include <Geode/utils/file.hpp>
 #include <Geode/utils/string.hpp>
 
 using namespace geode::prelude;
@@ -73,7 +74,7 @@ void updater::fetchLatestGithubRelease(
         req.get("https://api.github.com/repos/geode-sdk/geode/releases/latest").map(
             [expect = std::move(expect), then = std::move(then)](web::WebResponse* response) {
                 if (response->ok()) {
-                    if (response->data().empty()) {
+                    if (response->dataView().empty()) {
                         expect("Empty response");
                     }
                     else {
@@ -138,11 +139,12 @@ void updater::tryDownloadLoaderResources(std::string const& url, bool tryLatestO
     if (RUNNING_REQUESTS.contains(url)) return;
 
     auto req = web::WebRequest();
+    req.intoFile(tempResourcesZip);
     RUNNING_REQUESTS.emplace(url, req.get(url).map(
-        [url, resourcesDir](web::WebResponse* response) {
+        [url, resourcesDir, tempResourcesZip](web::WebResponse* response) {
             if (response->ok()) {
                 // unzip resources zip
-                auto unzip = file::Unzip::create(response->data());
+                auto unzip = file::Unzip::create(tempResourcesZip);
                 if (unzip) {
                     auto ok = unzip->extractAllTo(resourcesDir);
                     if (ok) {
@@ -267,22 +269,87 @@ bool updater::verifyLoaderResources() {
         return true;
     }
 
-    // make sure every file was covered
-    size_t coverage = 0;
-
-    // verify hashes
+    struct Resource {
+        std::filesystem::path path;
+        std::string name;
+        std::string stamp;
+        std::string hash;
+    };
+    std::vector<Resource> resources;
     for (auto& file : std::filesystem::directory_iterator(resourcesDir)) {
         auto name = file.path().filename().string();
         // skip unknown files
         if (!LOADER_RESOURCE_HASHES.count(name)) {
             continue;
         }
-        // verify hash
-        // if we hash anything other than text, change this
-        auto hash = calculateSHA256Text(file.path());
-        const auto& expected = LOADER_RESOURCE_HASHES.at(name);
-        if (hash != expected) {
-            log::debug("Resource hash mismatch: {} ({}, {})", name, hash.substr(0, 7), expected.substr(0, 7));
+        resources.push_back({ file.path(), name, LoaderImpl::getFileStamp(file.path()), "" });
+    }
+
+    // files that haven't changed since the last launch keep their hash from
+    // the resource index, so usually nothing needs to be hashed at all
+    auto indexPath = dirs::getGeodeDir() / "resource-index.json";
+    matjson::Value oldIndex = matjson::Object();
+    if (std::filesystem::exists(indexPath)) {
+        auto res = file::readJson(indexPath);
+        if (res && res.unwrap().is_object()) {
+            oldIndex = res.unwrap();
+        }
+    }
+    std::vector<Resource*> toHash;
+    for (auto& resource : resources) {
+        auto const& key = resource.name;
+        if (
+            !resource.stamp.empty() && oldIndex.contains(key) &&
+            oldIndex[key].is_object() &&
+            oldIndex[key].contains("stamp") && oldIndex[key]["stamp"].is_string() &&
+            oldIndex[key]["stamp"].as_string() == resource.stamp &&
+            oldIndex[key].contains("hash") && oldIndex[key]["hash"].is_string()
+        ) {
+            resource.hash = oldIndex[key]["hash"].as_string();
+        }
+        else {
+            toHash.push_back(&resource);
+        }
+    }
+    if (!toHash.empty()) {
+        ThreadPool pool("Resource Verifier", std::min(toHash.size(), ThreadPool::getDefaultThreadCount()));
+        for (auto resource : toHash) {
+            pool.push([resource]() {
+                // if we hash anything other than text, change this
+                resource->hash = calculateSHA256Text(resource->path);
+            });
+        }
+        pool.wait();
+    }
+    log::debug("Hashed {} resources, {} were unchanged", toHash.size(), resources.size() - toHash.size());
+
+    matjson::Value newIndex = matjson::Object();
+    for (auto const& resource : resources) {
+        if (!resource.stamp.empty()) {
+            newIndex[resource.name] = matjson::Object {
+                { "stamp", resource.stamp },
+                { "hash", resource.hash },
+            };
+        }
+    }
+    if (newIndex != oldIndex) {
+        auto res = file::writeString(indexPath, newIndex.dump(matjson::NO_INDENTATION));
+        if (!res) {
+            log::warn("Unable to save resource index: {}", res.unwrapErr());
+        }
+    }
+
+    // make sure every file was covered
+    size_t coverage = 0;
+
+    // verify hashes
+    for (auto const& resource : resources) {
+        const auto& expected = LOADER_RESOURCE_HASHES.at(resource.name);
+        if (resource.hash != expected) {
+            log::debug(
+                "Resource hash mismatch: {} ({}, {})",
+                resource.name, resource.hash.substr(0, 7), expected.substr(0, 7)
+            );
             updater::downloadLoaderResources();
             return false;
         }
@@ -306,13 +373,14 @@ void updater::downloadLoaderUpdate(std::string const& url) {
     if (RUNNING_REQUESTS.contains("@downloadLoaderUpdate")) return;
 
     auto req = web::WebRequest();
+    req.intoFile(updateZip);
     RUNNING_REQUESTS.emplace(
         "@downloadLoaderUpdate",
         req.get(url).map(
-            [targetDir](web::WebResponse* response) {
+            [targetDir, updateZip](web::WebResponse* response) {
                 if (response->ok()) {
                     // unzip resources zip
-                    auto unzip = file::Unzip::create(response->data());
+                    auto unzip = file::Unzip::create(updateZip);
                     if (unzip) {
                         auto ok = unzip->extractAllTo(targetDir);
                         if (ok) {
@@ -20,6 +20,11 @@ namespace {
 void console::setup() { }
 void console::openIfClosed() { }
 
+// logcat is always there
+bool console::isOpen() {
+    return true;
+}
+
 void console::log(std::string const& msg, Severity severity) {
     __android_log_print(
         getLogSeverityForSeverity(severity),
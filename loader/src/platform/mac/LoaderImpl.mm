@@ -29,6 +29,10 @@ void console::messageBox(char const* title, std::string const& info, Severity) {
     );
 }
 
+bool console::isOpen() {
+    return s_isOpen;
+}
+
 void console::log(std::string const& msg, Severity severity) {
     if (s_isOpen) {
         int colorcode = 0;
@@ -160,6 +160,10 @@ void console::openIfClosed() {
     setupConsole();
 }
 
+bool console::isOpen() {
+    return s_outHandle != nullptr;
+}
+
 void console::log(std::string const& msg, Severity severity) {
     if (!s_outHandle)
         return;
@@ -18,6 +18,7 @@
 #include <string>
 #include <fmt/core.h>
 #include "ehdata_structs.hpp"
+#include "../../utils/thread.hpp"
 
 using namespace geode::prelude;
 
@@ -457,7 +458,11 @@ static std::string getInfo(LPEXCEPTION_POINTERS info, Mod* faultyMod, Mod* suspe
     }
 
     // show the thread that crashed
-    stream << "Crashed thread: " << utils::thread::getName() << "\n";
+    stream << "Crashed thread: " << utils::thread::getName();
+    if (auto task = utils::thread::getTaskName()) {
+        stream << " (running Task '" << *task << "')";
+    }
+    stream << "\n";
 
     return stream.str();
 }
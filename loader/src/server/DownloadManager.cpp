@@ -101,11 +101,18 @@ public:
             .percentage = 0,
         };
 
-        m_downloadListener.bind([this, hash = version.hash](web::WebTask::Event* event) {
+        // The package is streamed into a file next to where it'll end up 
+        // and hashed while it's downloaded, so it never has to be in memory
+        auto downloadPath = dirs::getModsDir() / (m_id + ".geode.download");
+        auto hasher = std::make_shared<SHA256Hasher>();
+
+        m_downloadListener.bind([this, hash = version.hash, downloadPath, hasher](web::WebTask::Event* event) {
             if (auto value = event->getValue()) {
                 if (value->ok()) {
-                    if (auto actualHash = ::calculateHash(value->data()); actualHash != hash) {
+                    if (auto actualHash = hasher->finish(); actualHash != hash) {
                         log::error("Failed to download {}, hash mismatch ({} != {})", m_id, actualHash, hash);
+                        std::error_code ec;
+                        std::filesystem::remove(downloadPath, ec);
                         m_status = DownloadStatusError {
                             .details = "Hash mismatch, downloaded file did not match what was expected",
                         };
@@ -127,16 +134,21 @@ public:
                     }
                     // If this was an update, delete the old file first
                     if (!removingInstalledWasError) {
-                        auto ok = file::writeBinary(dirs::getModsDir() / (m_id + ".geode"), value->data());
-                        if (!ok) {
+                        std::error_code ec;
+                        std::filesystem::rename(downloadPath, dirs::getModsDir() / (m_id + ".geode"), ec);
+                        if (ec) {
                             m_status = DownloadStatusError {
-                                .details = ok.unwrapErr(),
+                                .details = fmt::format("Unable to move downloaded .geode package (code {})", ec),
                             };
                         }
                         else {
                             m_status = DownloadStatusDone();
                         }
                     }
+                    else {
+                        std::error_code ec;
+                        std::filesystem::remove(downloadPath, ec);
+                    }
                 }
                 else {
                     m_status = DownloadStatusError {
@@ -157,6 +169,10 @@ public:
 
         auto req = web::WebRequest();
         req.userAgent(getServerUserAgent());
+        req.intoFile(downloadPath);
+        req.onChunk([hasher](std::span<const uint8_t> chunk) {
+            hasher->update(chunk);
+        });
         m_downloadListener.setFilter(req.get(version.downloadURL));
         ModDownloadEvent(m_id).post();
     }
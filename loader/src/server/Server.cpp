@@ -2,6 +2,7 @@
 #include <Geode/utils/JsonValidation.hpp>
 #include <Geode/utils/ranges.hpp>
 #include <chrono>
+#include <list>
 #include <date/date.h>
 #include <fmt/core.h>
 #include <loader/ModMetadataImpl.hpp>
@@ -13,74 +14,256 @@ using namespace server;
 
 #define GEODE_GD_VERSION_STR GEODE_STR(GEODE_GD_VERSION)
 
+// Hashes cache keys; keys are tuples of the cached function's arguments
+struct CacheKeyHash final {
+    static void combine(size_t& seed, size_t value) {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    template <class T>
+    static size_t hash(T const& value) {
+        if constexpr (requires { std::hash<T>()(value); }) {
+            return std::hash<T>()(value);
+        }
+        else {
+            // equal keys still compare equal, so this only costs speed
+            return 0;
+        }
+    }
+    template <class T>
+    static size_t hash(std::optional<T> const& value) {
+        return value ? hash(*value) + 1 : 0;
+    }
+    template <class T>
+    static size_t hash(std::unordered_set<T> const& value) {
+        // has to be independent of iteration order
+        size_t seed = value.size();
+        for (auto const& item : value) {
+            seed += hash(item) * 0x9e3779b97f4a7c15ull;
+        }
+        return seed;
+    }
+    template <class... Ts>
+    static size_t hash(std::variant<Ts...> const& value) {
+        size_t seed = value.index();
+        combine(seed, std::visit([](auto const& item) { return hash(item); }, value));
+        return seed;
+    }
+    template <class... Ts>
+    static size_t hash(std::tuple<Ts...> const& value) {
+        size_t seed = 0;
+        std::apply([&](auto const&... items) { (combine(seed, hash(items)), ...); }, value);
+        return seed;
+    }
+    static size_t hash(VersionInfo const& value) {
+        size_t seed = value.getMajor();
+        combine(seed, value.getMinor());
+        combine(seed, value.getPatch());
+        return seed;
+    }
+    static size_t hash(ModVersionMajor const& value) {
+        return value.major;
+    }
+    static size_t hash(ModsQuery const& value) {
+        size_t seed = hash(value.query);
+        combine(seed, hash(value.platforms));
+        combine(seed, hash(value.tags));
+        combine(seed, hash(value.featured));
+        combine(seed, static_cast<size_t>(value.sorting));
+        combine(seed, hash(value.developer));
+        combine(seed, value.page);
+        combine(seed, value.pageSize);
+        return seed;
+    }
+};
+
+// Rough number of bytes a cached value keeps alive, so a cache full of mod
+// logos counts for more than one full of tag lists
+struct CacheSize final {
+    template <class T>
+    static size_t of(T const&) {
+        return sizeof(T);
+    }
+    static size_t of(std::string const& value) {
+        return sizeof(value) + value.capacity();
+    }
+    static size_t of(ByteVector const& value) {
+        return sizeof(value) + value.capacity();
+    }
+    template <class T>
+    static size_t of(std::optional<T> const& value) {
+        return value ? of(*value) : sizeof(value);
+    }
+    template <class T>
+    static size_t of(std::vector<T> const& value) {
+        size_t size = sizeof(value) + (value.capacity() - value.size()) * sizeof(T);
+        for (auto const& item : value) {
+            size += of(item);
+        }
+        return size;
+    }
+    template <class T>
+    static size_t of(std::unordered_set<T> const& value) {
+        size_t size = sizeof(value);
+        for (auto const& item : value) {
+            size += of(item);
+        }
+        return size;
+    }
+    static size_t of(ServerModVersion const& value) {
+        // mod metadata is mostly strings parsed out of mod.json
+        return sizeof(value) + value.metadata.getRawJSON().dump(matjson::NO_INDENTATION).size();
+    }
+    static size_t of(ServerModMetadata const& value) {
+        return sizeof(value) + of(value.id) + of(value.developers) + of(value.versions) +
+            of(value.tags) + of(value.about) + of(value.changelog) + of(value.repository);
+    }
+    static size_t of(ServerModsList const& value) {
+        return sizeof(value) + of(value.mods);
+    }
+    template <class T>
+    static size_t of(ServerRequest<T>& request) {
+        auto result = request.getFinishedValue();
+        if (result && result->isOk()) {
+            return of(result->unwrap());
+        }
+        return sizeof(request);
+    }
+};
+
+struct CacheStats final {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+};
+
+// An LRU cache limited both by item count and by the estimated size of the
+// values in it. Values are server requests, whose size is only known once
+// they finish, so sizes are updated whenever the cache is touched
 template <class K, class V>
-    requires std::equality_comparable<K> && std::copy_constructible<K>
 class CacheMap final {
 private:
-    // I know this looks like a goofy choice over just
-    // `std::unordered_map`, but hear me out:
-    //
-    // This needs preserved insertion order (so shrinking the cache
-    // to match size limits doesn't just have to erase random
-    // elements)
-    //
-    // If this used a map for values and another vector for storing
-    // insertion order, it would have a pretty big memory footprint
-    // (two copies of Query, one for order, one for map + two heap
-    // allocations on top of that)
-    //
-    // In addition, it would be a bad idea to have a cache of 1000s
-    // of items in any case (since that would likely take up a ton
-    // of memory, which we want to avoid since it's likely many
-    // crashes with the old index were due to too much memory
-    // usage)
-    //
-    // Linear searching a vector of at most a couple dozen items is
-    // lightning-fast (🚀), and besides the main performance benefit
-    // comes from the lack of a web request - not how many extra
-    // milliseconds we can squeeze out of a map access
-    std::vector<std::pair<K, V>> m_values;
+    struct Entry final {
+        K key;
+        V value;
+        size_t size;
+        bool sized;
+    };
+    struct KeyHash final {
+        size_t operator()(K const& key) const {
+            return CacheKeyHash::hash(key);
+        }
+    };
+
+    // most recently used first
+    std::list<Entry> m_entries;
+    std::unordered_map<
+        std::reference_wrapper<K const>, typename std::list<Entry>::iterator,
+        KeyHash, std::equal_to<K>
+    > m_index;
     size_t m_sizeLimit = 20;
+    size_t m_byteLimit = 16 * 1024 * 1024;
+    size_t m_byteSize = 0;
+    size_t m_unsizedCount = 0;
+    CacheStats m_stats;
+
+    void updateSize(Entry& entry) {
+        if (entry.sized) {
+            return;
+        }
+        auto size = sizeof(Entry) + CacheSize::of(entry.value);
+        m_byteSize = m_byteSize - entry.size + size;
+        entry.size = size;
+        // once a request is done its value doesn't change anymore
+        if (entry.value.isFinished() || entry.value.isCancelled()) {
+            entry.sized = true;
+            m_unsizedCount -= 1;
+        }
+    }
+    void updateSizes() {
+        if (m_unsizedCount > 0) {
+            for (auto& entry : m_entries) {
+                this->updateSize(entry);
+            }
+        }
+    }
+    // only done when something is added or the limits change, so that just
+    // looking at the cache's size doesn't change what's in it
+    void trim() {
+        this->updateSizes();
+        // always keeps the most recent entry, even if it's over the budget
+        // on its own
+        while (
+            m_entries.size() > 1 &&
+            (m_entries.size() > m_sizeLimit || m_byteSize > m_byteLimit)
+        ) {
+            this->erase(std::prev(m_entries.end()));
+            m_stats.evictions += 1;
+        }
+    }
+    void erase(typename std::list<Entry>::iterator it) {
+        m_index.erase(it->key);
+        m_byteSize -= it->size;
+        if (!it->sized) {
+            m_unsizedCount -= 1;
+        }
+        m_entries.erase(it);
+    }
 
 public:
-    std::optional<V> get(K const& key) {
-        auto it = std::find_if(m_values.begin(), m_values.end(), [key](auto const& q) {
-            return q.first == key;
-        });
-        if (it != m_values.end()) {
-            return it->second;
+    V* get(K const& key) {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            m_stats.misses += 1;
+            return nullptr;
         }
-        return std::nullopt;
+        m_stats.hits += 1;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        this->updateSize(*it->second);
+        return &it->second->value;
     }
     void add(K&& key, V&& value) {
-        auto pair = std::make_pair(std::move(key), std::move(value));
-
-        // Shift and replace last element if we're at cache size limit
-        if (m_values.size() >= m_sizeLimit) {
-            std::shift_left(m_values.begin(), m_values.end(), 1);
-            m_values.back() = std::move(pair);
-        }
-        // Otherwise append at end
-        else {
-            m_values.emplace_back(std::move(pair));
-        }
+        this->remove(key);
+        m_entries.push_front(Entry { std::move(key), std::move(value), 0, false });
+        m_index.emplace(m_entries.front().key, m_entries.begin());
+        m_unsizedCount += 1;
+        this->updateSize(m_entries.front());
+        this->trim();
     }
     void remove(K const& key) {
-        ranges::remove(m_values, [&key](auto const& q) { return q.first == key; });
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            this->erase(it->second);
+        }
     }
     void clear() {
-        m_values.clear();
+        m_index.clear();
+        m_entries.clear();
+        m_byteSize = 0;
+        m_unsizedCount = 0;
     }
     void limit(size_t size) {
-        m_sizeLimit = size;
-        m_values.clear();
+        m_sizeLimit = std::max<size_t>(size, 1);
+        this->trim();
+    }
+    void byteLimit(size_t bytes) {
+        m_byteLimit = bytes;
+        this->trim();
     }
     size_t size() const {
-        return m_values.size();
+        return m_entries.size();
+    }
+    // can be over the byte limit if requests grew since the last trim
+    size_t byteSize() {
+        this->updateSizes();
+        return m_byteSize;
     }
     size_t limit() const {
         return m_sizeLimit;
     }
+    CacheStats const& stats() const {
+        return m_stats;
+    }
 };
 
 template <class F>
@@ -120,11 +303,12 @@ public:
     template <class... Args>
     ServerRequest<Value> get(Args const&... args) {
         std::unique_lock lock(m_mutex);
-        if (auto v = m_cache.get(Extract::key(args...))) {
+        auto key = Extract::key(args...);
+        if (auto v = m_cache.get(key)) {
             return *v;
         }
         auto f = Extract::invoke(F, args...);
-        m_cache.add(Extract::key(args...), ServerRequest<Value>(f));
+        m_cache.add(std::move(key), ServerRequest<Value>(f));
         return f;
     }
 
@@ -142,10 +326,26 @@ public:
         std::unique_lock lock(m_mutex);
         m_cache.limit(size);
     }
+    void byteLimit(size_t bytes) {
+        std::unique_lock lock(m_mutex);
+        m_cache.byteLimit(bytes);
+    }
     void clear() {
         std::unique_lock lock(m_mutex);
         m_cache.clear();
     }
+    ServerCacheStats stats(std::string_view name) {
+        std::unique_lock lock(m_mutex);
+        auto const& stats = m_cache.stats();
+        return ServerCacheStats {
+            .name = std::string(name),
+            .entries = m_cache.size(),
+            .bytes = m_cache.byteSize(),
+            .hits = stats.hits,
+            .misses = stats.misses,
+            .evictions = stats.evictions,
+        };
+    }
 };
 
 template <auto F>
@@ -536,7 +736,12 @@ bool ServerModMetadata::hasUpdateForInstalledMod() const {
 }
 
 std::string server::getServerAPIBaseURL() {
-    return "https://api.geode-sdk.org/v1";
+    // can be pointed at a local index server for testing with
+    // --geode:server-api-url=http://localhost:8080/v1
+    static const auto value = [] {
+        return Loader::get()->getLaunchArgument("server-api-url").value_or("https://api.geode-sdk.org/v1");
+    }();
+    return value;
 }
 
 template <class... Args>
@@ -565,6 +770,7 @@ ServerRequest<ServerModsList> server::getMods(ModsQuery const& query, bool useCa
 
     auto req = web::WebRequest();
     req.userAgent(getServerUserAgent());
+    req.diskCache(true);
 
     // Add search params
     if (query.query) {
@@ -633,6 +839,7 @@ ServerRequest<ServerModMetadata> server::getMod(std::string const& id, bool useC
     }
     auto req = web::WebRequest();
     req.userAgent(getServerUserAgent());
+    req.diskCache(true);
     return req.get(formatServerURL("/mods/{}", id)).map(
         [](web::WebResponse* response) -> Result<ServerModMetadata, ServerError> {
             if (response->ok()) {
@@ -717,6 +924,7 @@ ServerRequest<ByteVector> server::getModLogo(std::string const& id, bool useCach
     }
     auto req = web::WebRequest();
     req.userAgent(getServerUserAgent());
+    req.diskCache(true);
     return req.get(formatServerURL("/mods/{}/logo", id)).map(
         [](web::WebResponse* response) -> Result<ByteVector, ServerError> {
             if (response->ok()) {
@@ -736,6 +944,7 @@ ServerRequest<std::unordered_set<std::string>> server::getTags(bool useCache) {
     }
     auto req = web::WebRequest();
     req.userAgent(getServerUserAgent());
+    req.diskCache(true);
     return req.get(formatServerURL("/tags")).map(
         [](web::WebResponse* response) -> Result<std::unordered_set<std::string>, ServerError> {
             if (response->ok()) {
@@ -788,6 +997,7 @@ ServerRequest<std::optional<ServerModUpdate>> server::checkUpdates(Mod const* mo
 ServerRequest<std::vector<ServerModUpdate>> server::batchedCheckUpdates(std::vector<std::string> const& batch) {
     auto req = web::WebRequest();
     req.userAgent(getServerUserAgent());
+    req.diskCache(true);
     req.param("platform", GEODE_PLATFORM_SHORT_IDENTIFIER);
     req.param("gd", GEODE_GD_VERSION_STR);
     req.param("geode", Loader::get()->getVersion().toNonVString());
@@ -901,12 +1111,36 @@ void server::clearServerCaches(bool clearGlobalCaches) {
     }
 }
 
+std::vector<ServerCacheStats> server::getServerCacheStats() {
+    return {
+        getCache<&getMods>().stats("getMods"),
+        getCache<&getMod>().stats("getMod"),
+        getCache<&getModVersion>().stats("getModVersion"),
+        getCache<&getModLogo>().stats("getModLogo"),
+        getCache<&getTags>().stats("getTags"),
+        getCache<&checkAllUpdates>().stats("checkAllUpdates"),
+    };
+}
+
+static void limitServerCaches(int64_t size) {
+    getCache<&server::getMods>().limit(size);
+    getCache<&server::getMod>().limit(size);
+    getCache<&server::getModLogo>().limit(size);
+    getCache<&server::getTags>().limit(size);
+    getCache<&server::checkAllUpdates>().limit(size);
+}
+
+static void limitServerCacheMemory(int64_t megabytes) {
+    // split between the caches that actually hold onto a lot of data
+    auto bytes = static_cast<size_t>(megabytes) * 1024 * 1024;
+    getCache<&server::getMods>().byteLimit(bytes / 2);
+    getCache<&server::getMod>().byteLimit(bytes / 4);
+    getCache<&server::getModLogo>().byteLimit(bytes / 4);
+}
+
 $on_mod(Loaded) {
-    listenForSettingChanges<int64_t>("server-cache-size-limit", +[](int64_t size) {
-        getCache<&server::getMods>().limit(size);
-        getCache<&server::getMod>().limit(size);
-        getCache<&server::getModLogo>().limit(size);
-        getCache<&server::getTags>().limit(size);
-        getCache<&server::checkAllUpdates>().limit(size);
-    });
+    limitServerCaches(Mod::get()->getSettingValue<int64_t>("server-cache-size-limit"));
+    limitServerCacheMemory(Mod::get()->getSettingValue<int64_t>("server-cache-memory-limit"));
+    listenForSettingChanges<int64_t>("server-cache-size-limit", &limitServerCaches);
+    listenForSettingChanges<int64_t>("server-cache-memory-limit", &limitServerCacheMemory);
 }
@@ -162,4 +162,15 @@ namespace server {
     ServerRequest<std::vector<ServerModUpdate>> checkAllUpdates(bool useCache = true);
 
     void clearServerCaches(bool clearGlobalCaches = false);
+
+    struct ServerCacheStats final {
+        std::string name;
+        size_t entries;
+        // estimated memory used by the cached values
+        size_t bytes;
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+    };
+    std::vector<ServerCacheStats> getServerCacheStats();
 }
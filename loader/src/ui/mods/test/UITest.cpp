@@ -17,6 +17,7 @@ protected:
     CCLabelBMFont* m_rawTaskState;
     CCMenuItemSpriteExtra* m_cancelTaskBtn;
     CCMenuItemSpriteExtra* m_cancelServerTaskBtn;
+    CCLabelBMFont* m_cacheStats;
     EventListener<web::WebTask> m_rawListener;
     EventListener<StrTask> m_strListener;
     EventListener<server::ServerRequest<server::ServerModsList>> m_serListener;
@@ -77,6 +78,13 @@ protected:
         );
         m_buttonMenu->addChildAtPosition(clearServerCacheBtn, Anchor::Center, ccp(0, -70));
 
+        m_cacheStats = CCLabelBMFont::create("", "chatFont.fnt");
+        m_cacheStats->setScale(.4f);
+        m_cacheStats->setAnchorPoint({ .5f, 0 });
+        m_mainLayer->addChildAtPosition(m_cacheStats, Anchor::Bottom, ccp(0, 5));
+        this->updateCacheStats(0);
+        this->schedule(schedule_selector(GUITestPopup::updateCacheStats), 1.f);
+
         m_rawListener.bind(this, &GUITestPopup::onRawTask);
         m_strListener.bind(this, &GUITestPopup::onStrTask);
         m_serListener.bind(this, &GUITestPopup::onServerTask);
@@ -159,6 +167,18 @@ protected:
     void onServerCacheClear(CCObject*) {
         server::clearServerCaches(true);
         clearAllModListSourceCaches();
+        this->updateCacheStats(0);
+    }
+    void updateCacheStats(float) {
+        std::string text;
+        for (auto const& stats : server::getServerCacheStats()) {
+            text += fmt::format(
+                "{}: {} items, {} KB, {} hits, {} misses, {} evicted\n",
+                stats.name, stats.entries, stats.bytes / 1024,
+                stats.hits, stats.misses, stats.evictions
+            );
+        }
+        m_cacheStats->setString(text.c_str());
     }
 
 public:
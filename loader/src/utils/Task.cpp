@@ -0,0 +1,161 @@
+#include <Geode/utils/Task.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fmt/format.h>
+#include <thread>
+#include "thread.hpp"
+
+using namespace geode::prelude;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Runs jobs on a set of worker threads that grows as needed, up to a
+     * limit, and shrinks again once the workers have been idle for a while.
+     * Past the limit jobs go to the dedicated executor instead of waiting,
+     * since Task bodies used to always get their own thread and some block
+     * until other Tasks are done
+     */
+    class SharedTaskExecutor final : public TaskExecutor {
+    protected:
+        // workers that haven't had anything to do for this long exit
+        static constexpr auto IDLE_TIMEOUT = std::chrono::seconds(30);
+
+        struct QueuedJob final {
+            Job job;
+            std::string name;
+            Clock::time_point queuedAt;
+        };
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_jobAvailable;
+        std::deque<QueuedJob> m_jobs;
+        size_t m_maxThreadCount;
+        size_t m_threadCount = 0;
+        size_t m_idleCount = 0;
+        size_t m_nextThreadID = 1;
+        size_t m_startedCount = 0;
+        size_t m_spilledCount = 0;
+        std::chrono::microseconds m_totalLatency = std::chrono::microseconds(0);
+        std::chrono::microseconds m_maxLatency = std::chrono::microseconds(0);
+
+        void work(size_t id) {
+            utils::thread::setName(fmt::format("Task Worker #{}", id));
+
+            std::unique_lock lock(m_mutex);
+            while (true) {
+                m_idleCount += 1;
+                auto hasJob = m_jobAvailable.wait_for(lock, IDLE_TIMEOUT, [this] {
+                    return !m_jobs.empty();
+                });
+                m_idleCount -= 1;
+                if (!hasJob) {
+                    m_threadCount -= 1;
+                    return;
+                }
+
+                auto queued = std::move(m_jobs.front());
+                m_jobs.pop_front();
+
+                auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                    Clock::now() - queued.queuedAt
+                );
+                m_startedCount += 1;
+                m_totalLatency += latency;
+                m_maxLatency = std::max(m_maxLatency, latency);
+
+                lock.unlock();
+                utils::thread::setTaskName(&queued.name);
+                queued.job();
+                // destroy whatever the job captured before going idle
+                queued.job = nullptr;
+                utils::thread::setTaskName(nullptr);
+                lock.lock();
+            }
+        }
+
+    public:
+        SharedTaskExecutor()
+          // task bodies are mostly blocking on I/O (web requests, file
+          // reads) so having more workers than cores is fine
+          : m_maxThreadCount(std::max<size_t>(16, std::thread::hardware_concurrency() * 2))
+        {}
+
+        void post(Job&& job, std::string_view const name) override {
+            std::unique_lock lock(m_mutex);
+            if (m_jobs.size() < m_idleCount) {
+                m_jobs.push_back({ std::move(job), std::string(name), Clock::now() });
+                m_jobAvailable.notify_one();
+            }
+            else if (m_threadCount < m_maxThreadCount) {
+                m_jobs.push_back({ std::move(job), std::string(name), Clock::now() });
+                m_threadCount += 1;
+                std::thread([this, id = m_nextThreadID++] {
+                    this->work(id);
+                }).detach();
+            }
+            else {
+                m_spilledCount += 1;
+                lock.unlock();
+                TaskExecutor::getDedicated()->post(std::move(job), name);
+            }
+        }
+
+        TaskExecutorStats getStats() const override {
+            std::unique_lock lock(m_mutex);
+            TaskExecutorStats stats;
+            stats.threadCount = m_threadCount;
+            stats.idleThreadCount = m_idleCount;
+            stats.queuedCount = m_jobs.size();
+            stats.startedCount = m_startedCount;
+            stats.spilledCount = m_spilledCount;
+            if (m_startedCount) {
+                stats.averageQueueLatency = m_totalLatency / m_startedCount;
+            }
+            stats.maxQueueLatency = m_maxLatency;
+            return stats;
+        }
+    };
+
+    class DedicatedTaskExecutor final : public TaskExecutor {
+    protected:
+        std::atomic_size_t m_threadCount = 0;
+        std::atomic_size_t m_startedCount = 0;
+
+    public:
+        void post(Job&& job, std::string_view const name) override {
+            m_threadCount += 1;
+            m_startedCount += 1;
+            std::thread([this, job = std::move(job), name = std::string(name)] {
+                utils::thread::setName("Task Thread");
+                utils::thread::setTaskName(&name);
+                job();
+                utils::thread::setTaskName(nullptr);
+                m_threadCount -= 1;
+            }).detach();
+        }
+
+        TaskExecutorStats getStats() const override {
+            TaskExecutorStats stats;
+            stats.threadCount = m_threadCount;
+            stats.startedCount = m_startedCount;
+            return stats;
+        }
+    };
+}
+
+TaskExecutor::~TaskExecutor() = default;
+
+TaskExecutor* TaskExecutor::getShared() {
+    static auto inst = new SharedTaskExecutor();
+    return inst;
+}
+
+TaskExecutor* TaskExecutor::getDedicated() {
+    static auto inst = new DedicatedTaskExecutor();
+    return inst;
+}
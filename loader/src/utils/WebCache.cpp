@@ -0,0 +1,260 @@
+#include "WebCache.hpp"
+
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/loader/Log.hpp>
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/Task.hpp>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <hash.hpp>
+#include <matjson.hpp>
+
+using namespace geode::prelude;
+using namespace geode::utils::web;
+
+static int64_t now() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+}
+
+// header names are case-insensitive, and HTTP/2 sends them in lowercase
+static std::optional<std::string> findHeader(
+    std::unordered_map<std::string, std::string> const& headers, std::string_view name
+) {
+    for (auto const& [key, value] : headers) {
+        if (key.size() == name.size() && std::equal(key.begin(), key.end(), name.begin(), [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        })) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+WebDiskCache::WebDiskCache() : m_dir(dirs::getGeodeDir() / "web-cache") {}
+
+WebDiskCache& WebDiskCache::get() {
+    static WebDiskCache inst;
+    return inst;
+}
+
+void WebDiskCache::load() {
+    if (m_loaded) {
+        return;
+    }
+    m_loaded = true;
+
+    auto indexPath = m_dir / "index.json";
+    if (!std::filesystem::exists(indexPath)) {
+        return;
+    }
+    auto res = file::readJson(indexPath);
+    if (!res || !res.unwrap().is_object()) {
+        log::warn("Web cache index is invalid, clearing the cache");
+        std::error_code ec;
+        std::filesystem::remove_all(m_dir, ec);
+        return;
+    }
+    for (auto const& [url, value] : res.unwrap().as_object()) {
+        if (
+            !value.is_object() ||
+            !value.contains("file") || !value["file"].is_string() ||
+            !value.contains("size") || !value["size"].is_number()
+        ) {
+            continue;
+        }
+        Entry entry;
+        entry.file = value["file"].as_string();
+        entry.size = value["size"].as_int();
+        if (value.contains("etag") && value["etag"].is_string()) {
+            entry.etag = value["etag"].as_string();
+        }
+        if (value.contains("last-modified") && value["last-modified"].is_string()) {
+            entry.lastModified = value["last-modified"].as_string();
+        }
+        if (value.contains("last-used") && value["last-used"].is_number()) {
+            entry.lastUsed = value["last-used"].as_int();
+        }
+        m_totalSize += entry.size;
+        m_entries.insert({ url, std::move(entry) });
+    }
+}
+
+void WebDiskCache::save() {
+    m_dirty = true;
+    if (m_saving) {
+        return;
+    }
+    m_saving = true;
+    TaskExecutor::getShared()->post([this] {
+        std::unique_lock lock(m_mutex);
+        while (m_dirty) {
+            m_dirty = false;
+            matjson::Value index = matjson::Object();
+            for (auto const& [url, entry] : m_entries) {
+                index[url] = matjson::Object {
+                    { "file", entry.file },
+                    { "etag", entry.etag },
+                    { "last-modified", entry.lastModified },
+                    { "size", static_cast<double>(entry.size) },
+                    { "last-used", static_cast<double>(entry.lastUsed) },
+                };
+            }
+            auto dump = index.dump(matjson::NO_INDENTATION);
+
+            // the cache can be used again while the index is being written
+            lock.unlock();
+            (void)file::createDirectoryAll(m_dir);
+            auto res = file::writeString(m_dir / "index.json", dump);
+            if (!res) {
+                log::warn("Unable to save web cache index: {}", res.unwrapErr());
+            }
+            lock.lock();
+        }
+        m_saving = false;
+    }, "Web cache index");
+}
+
+void WebDiskCache::erase(std::unordered_map<std::string, Entry>::iterator it) {
+    std::error_code ec;
+    std::filesystem::remove(m_dir / it->second.file, ec);
+    m_totalSize -= it->second.size;
+    m_entries.erase(it);
+}
+
+void WebDiskCache::evict() {
+    // the cache only holds a few hundred responses at most, so finding the
+    // oldest one each time is fine
+    while (m_totalSize > m_sizeLimit && !m_entries.empty()) {
+        auto oldest = std::min_element(m_entries.begin(), m_entries.end(), [](auto const& a, auto const& b) {
+            return a.second.lastUsed < b.second.lastUsed;
+        });
+        this->erase(oldest);
+    }
+}
+
+std::vector<std::pair<std::string, std::string>> WebDiskCache::getConditionalHeaders(std::string const& url) {
+    std::lock_guard lock(m_mutex);
+    this->load();
+
+    std::vector<std::pair<std::string, std::string>> headers;
+    auto it = m_entries.find(url);
+    if (it == m_entries.end()) {
+        return headers;
+    }
+    if (!it->second.etag.empty()) {
+        headers.emplace_back("If-None-Match", it->second.etag);
+    }
+    if (!it->second.lastModified.empty()) {
+        headers.emplace_back("If-Modified-Since", it->second.lastModified);
+    }
+    return headers;
+}
+
+std::optional<ByteVector> WebDiskCache::read(std::string const& url) {
+    std::lock_guard lock(m_mutex);
+    this->load();
+
+    auto it = m_entries.find(url);
+    if (it == m_entries.end()) {
+        return std::nullopt;
+    }
+    auto res = file::readBinary(m_dir / it->second.file);
+    if (!res || res.unwrap().size() != it->second.size) {
+        log::warn("Cached response for {} is missing or damaged", url);
+        this->erase(it);
+        this->save();
+        return std::nullopt;
+    }
+    it->second.lastUsed = now();
+    this->save();
+    return std::move(res).unwrap();
+}
+
+void WebDiskCache::store(
+    std::string const& url,
+    std::unordered_map<std::string, std::string> const& headers,
+    ByteVector const& body
+) {
+    auto etag = findHeader(headers, "ETag");
+    auto lastModified = findHeader(headers, "Last-Modified");
+
+    std::lock_guard lock(m_mutex);
+    this->load();
+
+    bool replaced = false;
+    if (auto it = m_entries.find(url); it != m_entries.end()) {
+        this->erase(it);
+        replaced = true;
+    }
+    if ((!etag && !lastModified) || body.size() > m_sizeLimit) {
+        if (replaced) {
+            this->save();
+        }
+        return;
+    }
+
+    Entry entry;
+    entry.file = calculateHash(std::span(reinterpret_cast<const uint8_t*>(url.data()), url.size()));
+    entry.etag = etag.value_or("");
+    entry.lastModified = lastModified.value_or("");
+    entry.size = body.size();
+    entry.lastUsed = now();
+
+    (void)file::createDirectoryAll(m_dir);
+    auto res = file::writeBinary(m_dir / entry.file, body);
+    if (!res) {
+        log::warn("Unable to cache response for {}: {}", url, res.unwrapErr());
+        if (replaced) {
+            this->save();
+        }
+        return;
+    }
+    m_totalSize += entry.size;
+    m_entries.insert({ url, std::move(entry) });
+    this->evict();
+    this->save();
+}
+
+void WebDiskCache::remove(std::string const& url) {
+    std::lock_guard lock(m_mutex);
+    this->load();
+
+    if (auto it = m_entries.find(url); it != m_entries.end()) {
+        this->erase(it);
+        this->save();
+    }
+}
+
+void WebDiskCache::clear() {
+    std::lock_guard lock(m_mutex);
+    m_entries.clear();
+    m_totalSize = 0;
+    m_loaded = true;
+    std::error_code ec;
+    std::filesystem::remove_all(m_dir, ec);
+    // in case a save was already underway
+    if (m_saving) {
+        this->save();
+    }
+}
+
+void WebDiskCache::setSizeLimit(size_t bytes) {
+    std::lock_guard lock(m_mutex);
+    this->load();
+
+    m_sizeLimit = bytes;
+    auto count = m_entries.size();
+    this->evict();
+    if (m_entries.size() != count) {
+        this->save();
+    }
+}
+
+size_t WebDiskCache::getSize() {
+    std::lock_guard lock(m_mutex);
+    this->load();
+    return m_totalSize;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Geode/utils/general.hpp>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace geode::utils::web {
+    /**
+     * Keeps the bodies of GET responses that came with an ETag or
+     * Last-Modified header on disk, so later requests for the same URL can
+     * be sent as conditional requests and a 304 Not Modified response can
+     * be answered from disk. Least recently used responses are removed once
+     * the cache grows past its size limit
+     */
+    class WebDiskCache final {
+    private:
+        struct Entry final {
+            std::string file;
+            std::string etag;
+            std::string lastModified;
+            size_t size = 0;
+            // seconds since the unix epoch
+            int64_t lastUsed = 0;
+        };
+
+        std::mutex m_mutex;
+        std::filesystem::path m_dir;
+        std::unordered_map<std::string, Entry> m_entries;
+        size_t m_totalSize = 0;
+        size_t m_sizeLimit = 64 * 1024 * 1024;
+        bool m_loaded = false;
+        // set when the index has changed since it was last written
+        bool m_dirty = false;
+        bool m_saving = false;
+
+        WebDiskCache();
+
+        void load();
+        // writes the index on another thread; changes made while that's
+        // happening are written together afterwards
+        void save();
+        void erase(std::unordered_map<std::string, Entry>::iterator it);
+        void evict();
+
+    public:
+        static WebDiskCache& get();
+
+        /**
+         * Get the headers that make a request for `url` conditional on the
+         * cached response being outdated; empty if nothing is cached
+         */
+        std::vector<std::pair<std::string, std::string>> getConditionalHeaders(std::string const& url);
+        /**
+         * Get the cached body for `url`, after the server responded with
+         * 304 Not Modified to a conditional request
+         */
+        std::optional<ByteVector> read(std::string const& url);
+        /**
+         * Store a successful response for `url`; responses without an ETag
+         * or Last-Modified header can't be revalidated, so they aren't kept
+         */
+        void store(
+            std::string const& url,
+            std::unordered_map<std::string, std::string> const& headers,
+            ByteVector const& body
+        );
+        void remove(std::string const& url);
+        void clear();
+
+        void setSizeLimit(size_t bytes);
+        size_t getSize();
+    };
+}
@@ -4,7 +4,11 @@
 #include <Geode/utils/map.hpp>
 #include <Geode/utils/string.hpp>
 #include <matjson.hpp>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
+#include <thread>
+#include <unordered_set>
 #include <mz.h>
 #include <mz_os.h>
 #include <mz_strm.h>
@@ -16,6 +20,12 @@
 
 #ifdef GEODE_IS_WINDOWS
 #include <filesystem>
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #if defined(GEODE_IS_ANDROID) || defined(GEODE_IS_MACOS)
@@ -75,7 +85,16 @@ Result<ByteVector> utils::file::readBinary(std::filesystem::path const& path) {
     if (!in)
         return Err("Unable to open file");
 
-    return Ok(ByteVector(std::istreambuf_iterator<char>(in), {}));
+    // read everything at once instead of going through it byte by byte
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+        return Err("Unable to get file size");
+
+    ByteVector contents(size);
+    in.read(reinterpret_cast<char*>(contents.data()), size);
+    contents.resize(in.gcount());
+    return Ok(contents);
 }
 
 Result<> utils::file::writeString(std::filesystem::path const& path, std::string const& data) {
@@ -160,14 +179,153 @@ Result<std::vector<std::filesystem::path>> utils::file::readDirectory(
     return Ok(res);
 }
 
+// MappedFile
+
+class MappedFile::Impl final {
+public:
+    Path m_path;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef GEODE_IS_WINDOWS
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+
+    ~Impl() {
+#ifdef GEODE_IS_WINDOWS
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
+#else
+        if (m_data) {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+#endif
+    }
+};
+
+MappedFile::MappedFile(std::unique_ptr<Impl>&& impl) : m_impl(std::move(impl)) {}
+
+MappedFile::MappedFile(MappedFile&& other) : m_impl(std::move(other.m_impl)) {}
+
+MappedFile::~MappedFile() {}
+
+Result<MappedFile> MappedFile::create(Path const& path) {
+    auto impl = std::make_unique<Impl>();
+    impl->m_path = path;
+
+#ifdef GEODE_IS_WINDOWS
+    // let the file be renamed or deleted while it's mapped, so that mods 
+    // can still be updated or uninstalled while something is reading them
+    impl->m_file = CreateFileW(
+        path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+    if (impl->m_file == INVALID_HANDLE_VALUE) {
+        return Err("Unable to open file");
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(impl->m_file, &size)) {
+        return Err("Unable to get file size");
+    }
+    impl->m_size = static_cast<size_t>(size.QuadPart);
+
+    // empty files can't be mapped, but there's nothing to map anyway
+    if (impl->m_size) {
+        impl->m_mapping = CreateFileMappingW(impl->m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!impl->m_mapping) {
+            return Err("Unable to map file");
+        }
+        impl->m_data = static_cast<const uint8_t*>(MapViewOfFile(impl->m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!impl->m_data) {
+            return Err("Unable to map file");
+        }
+    }
+#else
+    auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return Err("Unable to open file");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return Err("Unable to get file size");
+    }
+    impl->m_size = static_cast<size_t>(info.st_size);
+
+    // empty files can't be mapped, but there's nothing to map anyway
+    if (impl->m_size) {
+        auto data = ::mmap(nullptr, impl->m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            return Err("Unable to map file");
+        }
+        impl->m_data = static_cast<const uint8_t*>(data);
+    }
+    // the mapping stays valid after the file is closed
+    ::close(fd);
+#endif
+
+    return Ok(MappedFile(std::move(impl)));
+}
+
+std::span<const uint8_t> MappedFile::data() const {
+    return std::span(m_impl->m_data, m_impl->m_size);
+}
+
+size_t MappedFile::size() const {
+    return m_impl->m_size;
+}
+
+MappedFile::Path MappedFile::getPath() const {
+    return m_impl->m_path;
+}
+
 // Unzip
 
 static constexpr auto MAX_ENTRY_PATH_LEN = 256;
 
+// entries are extracted to disk in pieces of this size
+static constexpr size_t ZIP_CHUNK_SIZE = 256 * 1024;
+
 struct ZipEntry {
     bool isDirectory;
     int64_t compressedSize;
     int64_t uncompressedSize;
+    // position of the entry in the central directory, for mz_zip_goto_entry
+    int64_t cdPosition;
+    // position of the entry's local header in the zip
+    int64_t diskOffset;
+    uint16_t compressionMethod;
+    uint16_t flags;
+};
+
+// a separate handle for reading an already opened zip, so multiple threads 
+// can read from it at once
+struct ZipReader final {
+    void* stream = nullptr;
+    void* handle = nullptr;
+
+    ZipReader() = default;
+    ZipReader(ZipReader const&) = delete;
+    ZipReader& operator=(ZipReader const&) = delete;
+
+    ~ZipReader() {
+        if (handle) {
+            mz_zip_close(handle);
+            mz_zip_delete(&handle);
+        }
+        if (stream) {
+            mz_stream_close(stream);
+            mz_stream_delete(&stream);
+        }
+    }
 };
 
 class Zip::Impl final {
@@ -179,20 +337,39 @@ private:
     void* m_stream = nullptr;
     int32_t m_mode;
     std::variant<Path, ByteVector> m_srcDest;
+    // zips being read from a file are mapped into memory when possible, 
+    // and then read like ones opened from memory
+    std::optional<MappedFile> m_mapping;
     std::unordered_map<Path, ZipEntry, path_hash_t> m_entries;
+    // entry names in the order they're in the central directory
+    std::vector<Path> m_entryOrder;
     utils::MiniFunction<void(uint32_t, uint32_t)> m_progressCallback;
 
-    Result<> init() {
+    // m_stream is set before anything can fail so the destructor cleans it up
+    Result<> openStream(void*& stream) {
+        // open stream from the mapped file
+        if (m_mapping) {
+            stream = mz_stream_mem_create();
+            if (!stream) {
+                return Err("Unable to create memory stream");
+            }
+            // the stream is only ever read from
+            auto data = m_mapping->data();
+            mz_stream_mem_set_buffer(stream, const_cast<uint8_t*>(data.data()), data.size());
+            if (mz_stream_open(stream, nullptr, MZ_OPEN_MODE_READ) != MZ_OK) {
+                return Err("Unable to read memory stream");
+            }
+        }
         // open stream from file
-        if (std::holds_alternative<Path>(m_srcDest)) {
+        else if (std::holds_alternative<Path>(m_srcDest)) {
             auto& path = std::get<Path>(m_srcDest);
             // open file
-            m_stream = mz_stream_os_create();
-            if (!m_stream) {
+            stream = mz_stream_os_create();
+            if (!stream) {
                 return Err("Unable to open file");
             }
             if (mz_stream_os_open(
-                m_stream,
+                stream,
                 reinterpret_cast<const char*>(path.u8string().c_str()),
                 m_mode
             ) != MZ_OK) {
@@ -202,31 +379,39 @@ private:
         // open stream from memory stream
         else {
             auto& src = std::get<ByteVector>(m_srcDest);
-            m_stream = mz_stream_mem_create();
-            if (!m_stream) {
+            stream = mz_stream_mem_create();
+            if (!stream) {
                 return Err("Unable to create memory stream");
             }
             // mz_stream_mem_set_buffer doesn't memcpy so we gotta store the data 
             // elsewhere
             if (m_mode == MZ_OPEN_MODE_READ) {
-                mz_stream_mem_set_buffer(m_stream, src.data(), src.size());
+                mz_stream_mem_set_buffer(stream, src.data(), src.size());
             }
             else {
-                mz_stream_mem_set_grow_size(m_stream, 128 * 1024);
+                mz_stream_mem_set_grow_size(stream, 128 * 1024);
             }
-            if (mz_stream_open(m_stream, nullptr, m_mode) != MZ_OK) {
+            if (mz_stream_open(stream, nullptr, m_mode) != MZ_OK) {
                 return Err("Unable to read memory stream");
             }
         }
+        return Ok();
+    }
 
-        // open zip
-        m_handle = mz_zip_create();
-        if (!m_handle) {
+    Result<> openZip(void*& handle, void* stream) {
+        handle = mz_zip_create();
+        if (!handle) {
             return Err("Unable to create zip handler");
         }
-        if (mz_zip_open(m_handle, m_stream, m_mode) != MZ_OK) {
+        if (mz_zip_open(handle, stream, m_mode) != MZ_OK) {
             return Err("Unable to open zip");
         }
+        return Ok();
+    }
+
+    Result<> init() {
+        GEODE_UNWRAP(this->openStream(m_stream));
+        GEODE_UNWRAP(this->openZip(m_handle, m_stream));
 
         // get list of entries
         if (!this->loadEntries()) {
@@ -254,7 +439,12 @@ private:
                 .isDirectory = mz_zip_entry_is_dir(m_handle) == MZ_OK,
                 .compressedSize = info->compressed_size,
                 .uncompressedSize = info->uncompressed_size,
+                .cdPosition = mz_zip_get_entry(m_handle),
+                .diskOffset = info->disk_offset,
+                .compressionMethod = info->compression_method,
+                .flags = info->flag,
             } });
+            m_entryOrder.push_back(filePath);
 
             err = mz_zip_goto_next_entry(m_handle);
         }
@@ -275,6 +465,15 @@ public:
         auto ret = std::make_unique<Impl>();
         ret->m_mode = mode;
         ret->m_srcDest = path;
+        // memory streams are limited to 2GB, anything larger has to be 
+        // read from the file normally. The mapping lives only as long as 
+        // this Unzip, which is why Unzips shouldn't be kept around
+        if (mode == MZ_OPEN_MODE_READ) {
+            auto mapping = MappedFile::create(path);
+            if (mapping && mapping.unwrap().size() && mapping.unwrap().size() <= INT32_MAX) {
+                ret->m_mapping.emplace(std::move(mapping).unwrap());
+            }
+        }
         GEODE_UNWRAP(ret->init());
         return Ok(std::move(ret));
     }
@@ -299,31 +498,59 @@ public:
         m_progressCallback = callback;
     }
 
-    Result<> extractAt(Path const& dir, Path const& name) {
-        auto entry = m_entries.at(name);
+    Result<std::unique_ptr<ZipReader>> openReader() {
+        auto reader = std::make_unique<ZipReader>();
+        GEODE_UNWRAP(this->openStream(reader->stream));
+        GEODE_UNWRAP(this->openZip(reader->handle, reader->stream));
+        return Ok(std::move(reader));
+    }
+
+    // Streams the entry into a file, using the buffer as scratch space. 
+    // Entries stored without compression are written straight from the 
+    // mapped zip when there is one
+    Result<> extractEntryTo(void* handle, ZipEntry const& entry, Path const& target, ByteVector& buffer) {
+        if (auto view = this->viewEntry(entry)) {
+            std::ofstream out(target, std::ios::out | std::ios::binary);
+            if (!out) {
+                return Err("Unable to open {} for writing", target);
+            }
+            out.write(reinterpret_cast<const char*>(view.unwrap().data()), view.unwrap().size());
+            if (!out) {
+                return Err("Unable to write to {}", target);
+            }
+            return Ok();
+        }
 
         GEODE_UNWRAP(
-            mzTry(mz_zip_entry_read_open(m_handle, 0, nullptr))
+            mzTry(mz_zip_goto_entry(handle, entry.cdPosition))
+            .expect("Unable to navigate to entry (code {error})")
+        );
+        GEODE_UNWRAP(
+            mzTry(mz_zip_entry_read_open(handle, 0, nullptr))
             .expect("Unable to open entry (code {error})")
         );
 
-        // if the file is empty, its data is empty (duh)
-        if (!entry.uncompressedSize) {
-            return Ok();
+        std::ofstream out(target, std::ios::out | std::ios::binary);
+        if (!out) {
+            mz_zip_entry_close(handle);
+            return Err("Unable to open {} for writing", target);
         }
-
-        ByteVector res;
-        res.resize(entry.uncompressedSize);
-        auto read = mz_zip_entry_read(m_handle, res.data(), entry.uncompressedSize);
-        if (read < 0) {
-            mz_zip_entry_close(m_handle);
-            return Err("Unable to read entry (code " + std::to_string(read) + ")");
+        while (true) {
+            auto read = mz_zip_entry_read(handle, buffer.data(), static_cast<int32_t>(buffer.size()));
+            if (read < 0) {
+                mz_zip_entry_close(handle);
+                return Err("Unable to read entry (code " + std::to_string(read) + ")");
+            }
+            if (read == 0) {
+                break;
+            }
+            out.write(reinterpret_cast<const char*>(buffer.data()), read);
+            if (!out) {
+                mz_zip_entry_close(handle);
+                return Err("Unable to write to {}", target);
+            }
         }
-
-        mz_zip_entry_close(m_handle);
-
-        GEODE_UNWRAP(file::createDirectoryAll((dir / name).parent_path()));
-        GEODE_UNWRAP(file::writeBinary(dir / name, res).expect("Unable to write to {}: {error}", dir / name));
+        mz_zip_entry_close(handle);
 
         return Ok();
     }
@@ -331,29 +558,15 @@ public:
     Result<> extractAllTo(Path const& dir) {
         GEODE_UNWRAP(file::createDirectoryAll(dir));
 
-        GEODE_UNWRAP(
-            mzTry(mz_zip_goto_first_entry(m_handle))
-            .expect("Unable to navigate to first entry (code {error})")
-        );
-
-        uint64_t numEntries;
-
-        GEODE_UNWRAP(
-            mzTry(mz_zip_get_number_entry(m_handle, &numEntries))
-            .expect("Unable to get number of entries (code {error})")
-        );
+        uint32_t numEntries = m_entryOrder.size();
+        uint32_t doneEntries = 0;
 
-        uint32_t currentEntry = 0;
-        // while not at MZ_END_OF_LIST
-        do {
-            mz_zip_file* info = nullptr;
-            if (mz_zip_entry_get_info(m_handle, &info) != MZ_OK) {
-                return Err("Unable to get entry info");
-            }
-            currentEntry++;
-
-            Path filePath;
-            filePath.assign(info->filename, info->filename + info->filename_size);
+        // Create all the directories first, so the files can then be 
+        // extracted in any order
+        std::vector<std::pair<Path, ZipEntry const*>> files;
+        std::unordered_set<Path, path_hash_t> createdDirs;
+        for (auto& filePath : m_entryOrder) {
+            auto& entry = m_entries.at(filePath);
 
             // make sure zip files like root/../../file.txt don't get extracted to 
             // avoid zip attacks
@@ -362,14 +575,13 @@ public:
 #else
             if (!std::filesystem::relative(dir / filePath, dir).empty()) {
 #endif
-                if (m_entries.at(filePath).isDirectory) {
-                    GEODE_UNWRAP(file::createDirectoryAll(dir / filePath));
+                auto target = entry.isDirectory ? dir / filePath : (dir / filePath).parent_path();
+                if (createdDirs.insert(target).second) {
+                    GEODE_UNWRAP(file::createDirectoryAll(target));
                 }
-                else {
-                    GEODE_UNWRAP(this->extractAt(dir, filePath));
-                }
-                if (m_progressCallback) {
-                    m_progressCallback(currentEntry, numEntries);
+                if (!entry.isDirectory) {
+                    files.push_back({ filePath, &entry });
+                    continue;
                 }
             }
             else {
@@ -378,32 +590,114 @@ public:
                     dir / filePath
                 );
             }
-        } while (mz_zip_goto_next_entry(m_handle) == MZ_OK);
+            doneEntries += 1;
+            if (m_progressCallback) {
+                m_progressCallback(doneEntries, numEntries);
+            }
+        }
 
-        return Ok();
-    }
+        // Small zips aren't worth starting threads for
+        size_t workerCount = std::min<size_t>(
+            std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 8),
+            files.size() / 16
+        );
+        if (workerCount <= 1) {
+            ByteVector buffer(ZIP_CHUNK_SIZE);
+            for (auto& [filePath, entry] : files) {
+                GEODE_UNWRAP(
+                    this->extractEntryTo(m_handle, *entry, dir / filePath, buffer)
+                    .expect("{error} (entry {})", filePath.string())
+                );
+                doneEntries += 1;
+                if (m_progressCallback) {
+                    m_progressCallback(doneEntries, numEntries);
+                }
+            }
+            return Ok();
+        }
 
-    Result<ByteVector> extract(Path const& name) {
-        if (!m_entries.count(name)) {
-            return Err("Entry not found");
+        // Each worker reads the zip through its own handle and takes the 
+        // next file that nobody has started on yet. Progress is reported 
+        // from this thread, like when extracting on one thread
+        std::vector<std::unique_ptr<ZipReader>> readers;
+        for (size_t i = 0; i < workerCount; i += 1) {
+            GEODE_UNWRAP_INTO(auto reader, this->openReader());
+            readers.push_back(std::move(reader));
+        }
+
+        std::atomic_size_t nextFile = 0;
+        std::mutex mutex;
+        std::condition_variable progressed;
+        size_t extractedFiles = 0;
+        size_t finishedWorkers = 0;
+        std::optional<std::string> error;
+
+        std::vector<std::thread> workers;
+        for (auto& reader : readers) {
+            workers.emplace_back([&, handle = reader->handle] {
+                ByteVector buffer(ZIP_CHUNK_SIZE);
+                while (true) {
+                    auto i = nextFile++;
+                    if (i >= files.size()) {
+                        break;
+                    }
+                    auto& [filePath, entry] = files[i];
+                    auto res = this->extractEntryTo(handle, *entry, dir / filePath, buffer);
+
+                    std::unique_lock lock(mutex);
+                    if (!res) {
+                        if (!error) {
+                            error = fmt::format("{} (entry {})", res.unwrapErr(), filePath.string());
+                        }
+                        // stop everyone else from picking up more files
+                        nextFile = files.size();
+                        break;
+                    }
+                    extractedFiles += 1;
+                    progressed.notify_one();
+                }
+                std::unique_lock lock(mutex);
+                finishedWorkers += 1;
+                progressed.notify_one();
+            });
+        }
+
+        {
+            std::unique_lock lock(mutex);
+            size_t reportedFiles = 0;
+            while (finishedWorkers < workers.size()) {
+                progressed.wait(lock);
+                if (m_progressCallback && reportedFiles < extractedFiles) {
+                    reportedFiles = extractedFiles;
+                    lock.unlock();
+                    m_progressCallback(doneEntries + reportedFiles, numEntries);
+                    lock.lock();
+                }
+            }
+            if (m_progressCallback && reportedFiles < extractedFiles) {
+                m_progressCallback(doneEntries + extractedFiles, numEntries);
+            }
         }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        if (error) {
+            return Err(*error);
+        }
+        return Ok();
+    }
 
-        auto entry = m_entries.at(name);
+    // Reads a whole entry into memory, jumping straight to it instead of 
+    // looking it up by name
+    Result<ByteVector> readEntry(ZipEntry const& entry) {
         if (entry.isDirectory) {
             return Err("Entry is directory");
         }
 
         GEODE_UNWRAP(
-            mzTry(mz_zip_goto_first_entry(m_handle))
-            .expect("Unable to navigate to first entry (code {error})")
-        );
-
-        GEODE_UNWRAP(
-            mzTry(mz_zip_locate_entry(
-                m_handle,
-                reinterpret_cast<const char*>(name.u8string().c_str()),
-                1
-            )).expect("Unable to navigate to entry (code {error})")
+            mzTry(mz_zip_goto_entry(m_handle, entry.cdPosition))
+            .expect("Unable to navigate to entry (code {error})")
         );
 
         GEODE_UNWRAP(
@@ -413,21 +707,108 @@ public:
 
         // if the file is empty, its data is empty (duh)
         if (!entry.uncompressedSize) {
+            mz_zip_entry_close(m_handle);
             return Ok(ByteVector());
         }
 
         ByteVector res;
         res.resize(entry.uncompressedSize);
-        auto read = mz_zip_entry_read(m_handle, res.data(), entry.uncompressedSize);
-        if (read < 0) {
-            mz_zip_entry_close(m_handle);
-            return Err("Unable to read entry (code " + std::to_string(read) + ")");
+        int64_t total = 0;
+        while (total < entry.uncompressedSize) {
+            auto read = mz_zip_entry_read(
+                m_handle, res.data() + total,
+                static_cast<int32_t>(std::min<int64_t>(entry.uncompressedSize - total, INT32_MAX))
+            );
+            if (read < 0) {
+                mz_zip_entry_close(m_handle);
+                return Err("Unable to read entry (code " + std::to_string(read) + ")");
+            }
+            if (read == 0) {
+                break;
+            }
+            total += read;
         }
         mz_zip_entry_close(m_handle);
+        res.resize(total);
 
         return Ok(res);
     }
 
+    Result<ByteVector> extract(Path const& name) {
+        auto it = m_entries.find(name);
+        if (it == m_entries.end()) {
+            return Err("Entry not found");
+        }
+        return this->readEntry(it->second);
+    }
+
+    Result<std::span<const uint8_t>> extractView(Path const& name) {
+        auto it = m_entries.find(name);
+        if (it == m_entries.end()) {
+            return Err("Entry not found");
+        }
+        return this->viewEntry(it->second);
+    }
+
+    Result<std::span<const uint8_t>> viewEntry(ZipEntry const& entry) {
+        if (entry.isDirectory) {
+            return Err("Entry is directory");
+        }
+        if (!m_mapping) {
+            return Err("Zip is not mapped into memory");
+        }
+        if (entry.compressionMethod != MZ_COMPRESS_METHOD_STORE || (entry.flags & MZ_ZIP_FLAG_ENCRYPTED)) {
+            return Err("Entry is compressed");
+        }
+
+        // the data comes right after the entry's local header, which is 30 
+        // bytes followed by the file name and extra field
+        constexpr size_t LOCAL_HEADER_SIZE = 30;
+        auto data = m_mapping->data();
+        auto offset = static_cast<size_t>(entry.diskOffset);
+        if (entry.diskOffset < 0 || offset + LOCAL_HEADER_SIZE > data.size()) {
+            return Err("Entry is out of bounds");
+        }
+        auto header = data.subspan(offset, LOCAL_HEADER_SIZE);
+        if (header[0] != 'P' || header[1] != 'K' || header[2] != 3 || header[3] != 4) {
+            return Err("Invalid local header");
+        }
+        auto readU16 = [&](size_t at) -> size_t {
+            return header[at] | (header[at + 1] << 8);
+        };
+        auto start = offset + LOCAL_HEADER_SIZE + readU16(26) + readU16(28);
+        auto size = static_cast<size_t>(entry.uncompressedSize);
+        if (start + size > data.size()) {
+            return Err("Entry is out of bounds");
+        }
+        return Ok(data.subspan(start, size));
+    }
+
+    Result<std::vector<ByteVector>> extractMany(std::vector<Path> const& names) {
+        std::vector<std::pair<size_t, ZipEntry const*>> toRead;
+        toRead.reserve(names.size());
+        for (size_t i = 0; i < names.size(); i += 1) {
+            auto it = m_entries.find(names[i]);
+            if (it == m_entries.end()) {
+                return Err("Entry not found (entry {})", names[i].string());
+            }
+            toRead.push_back({ i, &it->second });
+        }
+        // read in the order the data is in the file so the reads only go 
+        // forward
+        std::sort(toRead.begin(), toRead.end(), [](auto const& a, auto const& b) {
+            return a.second->diskOffset < b.second->diskOffset;
+        });
+
+        std::vector<ByteVector> res(names.size());
+        for (auto& [i, entry] : toRead) {
+            GEODE_UNWRAP_INTO(
+                res[i], this->readEntry(*entry).expect("{error} (entry {})", names[i].string())
+            );
+        }
+        return Ok(std::move(res));
+    }
+
     Result<> addFolder(Path const& path) {
         auto strPath = path.u8string();
         if (!strPath.ends_with(u8"/") && !strPath.ends_with(u8"\\")) {
@@ -495,8 +876,12 @@ public:
         return Path();
     }
 
-    std::unordered_map<Path, ZipEntry, path_hash_t> getEntries() const {
-        return m_entries;
+    std::vector<Path> const& getEntries() const {
+        return m_entryOrder;
+    }
+
+    bool hasEntry(Path const& name) const {
+        return m_entries.contains(name);
     }
 
     ~Impl() {
@@ -542,17 +927,25 @@ void Unzip::setProgressCallback(
 }
 
 std::vector<Unzip::Path> Unzip::getEntries() const {
-    return map::keys(m_impl->getEntries());
+    return m_impl->getEntries();
 }
 
 bool Unzip::hasEntry(Path const& name) {
-    return m_impl->getEntries().count(name);
+    return m_impl->hasEntry(name);
 }
 
 Result<ByteVector> Unzip::extract(Path const& name) {
     return m_impl->extract(name).expect("{error} (entry {})", name.string());
 }
 
+Result<std::vector<ByteVector>> Unzip::extractMany(std::vector<Path> const& names) {
+    return m_impl->extractMany(names);
+}
+
+Result<std::span<const uint8_t>> Unzip::extractView(Path const& name) {
+    return m_impl->extractView(name).expect("{error} (entry {})", name.string());
+}
+
 Result<> Unzip::extractTo(Path const& name, Path const& path) {
     GEODE_UNWRAP_INTO(auto bytes, m_impl->extract(name).expect("{error} (entry {})", name.string()));
     // create containing directories for target path
@@ -576,7 +969,6 @@ Result<> Unzip::intoDir(
     // removed
     {
         GEODE_UNWRAP_INTO(auto unzip, Unzip::create(from));
-        // TODO: this is quite slow lol, takes 30 seconds to extract index..
         GEODE_UNWRAP(unzip.extractAllTo(to));
     }
     if (deleteZipAfter) {
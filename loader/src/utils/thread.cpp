@@ -6,16 +6,30 @@ using namespace geode::prelude;
 #include <Geode/Utils.hpp>
 #include "thread.hpp"
 
-static thread_local std::string s_threadName;
+static thread_local std::shared_ptr<std::string const> s_threadName;
+static thread_local std::string const* s_taskName = nullptr;
 
 std::string geode::utils::thread::getName() {
+    return *getSharedName();
+}
+
+std::shared_ptr<std::string const> const& geode::utils::thread::getSharedName() {
     // only use the thread-local variable here, no need for platform get methods
-    if (s_threadName.empty())
-        return getDefaultName();
+    // more than once per thread
+    if (!s_threadName || s_threadName->empty())
+        s_threadName = std::make_shared<std::string const>(getDefaultName());
     return s_threadName;
 }
 
+void geode::utils::thread::setTaskName(std::string const* name) {
+    s_taskName = name;
+}
+
+std::string const* geode::utils::thread::getTaskName() {
+    return s_taskName;
+}
+
 void geode::utils::thread::setName(std::string const& name) {
-    s_threadName = name;
+    s_threadName = std::make_shared<std::string const>(name);
     platformSetName(name);
 }
@@ -1,9 +1,18 @@
 ﻿#pragma once
 
+#include <memory>
 #include <string>
 
 namespace geode::utils::thread {
     // the platform-specific methods are needed for the thread names to show up
     // in places like task managers and debuggers
     void platformSetName(std::string const& name);
+    // same as getName, but without copying the name every time; the name is
+    // shared so it can be kept around after the thread renames itself or exits
+    std::shared_ptr<std::string const> const& getSharedName();
+    // the name of the Task the calling thread is running, if any, so crash
+    // logs can tell what a worker was doing without it being renamed for
+    // every job; the name has to stay alive until it's set back to null
+    void setTaskName(std::string const* name);
+    std::string const* getTaskName();
 }
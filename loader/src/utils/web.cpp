@@ -12,7 +12,10 @@
 #include <Geode/utils/web.hpp>
 #include <Geode/utils/map.hpp>
 #include <Geode/utils/terminate.hpp>
+#include "WebCache.hpp"
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 using namespace geode::prelude;
 using namespace geode::utils::web;
@@ -92,6 +95,110 @@ static long unwrapHttpVersion(HttpVersion version)
     unreachable("Unexpected HTTP Version!");
 }
 
+namespace {
+    /**
+     * Performs all web requests on a single thread through one curl multi 
+     * handle, so requests to the same host reuse connections (and multiplex 
+     * over them with HTTP/2) instead of each one doing its own DNS lookup 
+     * and TLS handshake
+     */
+    class WebClient final {
+    public:
+        using OnDone = utils::MoveOnlyFunction<void(CURLcode)>;
+
+    protected:
+        struct Request final {
+            CURL* curl;
+            OnDone onDone;
+        };
+
+        CURLM* m_multi;
+        CURLSH* m_share;
+        std::mutex m_mutex;
+        std::vector<Request> m_queued;
+        std::unordered_map<CURL*, OnDone> m_running;
+
+        WebClient() {
+            curl_global_init(CURL_GLOBAL_DEFAULT);
+
+            m_multi = curl_multi_init();
+            curl_multi_setopt(m_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+            curl_multi_setopt(m_multi, CURLMOPT_MAX_HOST_CONNECTIONS, 8L);
+
+            // the multi handle already shares connections and the DNS cache 
+            // between its requests, but not TLS sessions. no lock functions 
+            // are needed as long as the share is only attached to handles and 
+            // used on the client thread, which is why `perform` doesn't set 
+            // CURLOPT_SHARE itself
+            m_share = curl_share_init();
+            curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+
+            std::thread([this] {
+                utils::thread::setName("Web Client");
+                this->run();
+            }).detach();
+        }
+
+        void run() {
+            while (true) {
+                {
+                    std::unique_lock lock(m_mutex);
+                    for (auto& request : m_queued) {
+                        curl_easy_setopt(request.curl, CURLOPT_SHARE, m_share);
+                        // prefer waiting for a connection to multiplex on 
+                        // over opening a new one
+                        curl_easy_setopt(request.curl, CURLOPT_PIPEWAIT, 1L);
+                        curl_multi_add_handle(m_multi, request.curl);
+                        m_running.emplace(request.curl, std::move(request.onDone));
+                    }
+                    m_queued.clear();
+                }
+
+                int running = 0;
+                curl_multi_perform(m_multi, &running);
+
+                int left = 0;
+                while (auto msg = curl_multi_info_read(m_multi, &left)) {
+                    if (msg->msg != CURLMSG_DONE) {
+                        continue;
+                    }
+                    // msg is invalidated by removing the handle
+                    auto curl = msg->easy_handle;
+                    auto result = msg->data.result;
+                    curl_multi_remove_handle(m_multi, curl);
+                    auto node = m_running.extract(curl);
+                    if (node) {
+                        node.mapped()(result);
+                    }
+                }
+
+                // sleep until there's activity, a new request or a second 
+                // passes (for timeouts and cancellation checks)
+                curl_multi_poll(m_multi, nullptr, 0, 1000, nullptr);
+            }
+        }
+
+    public:
+        static WebClient& get() {
+            static auto inst = new WebClient();
+            return *inst;
+        }
+
+        /**
+         * Start performing a request; ownership of the handle goes to the 
+         * client until `onDone` is called (on the client thread)
+         */
+        void perform(CURL* curl, OnDone&& onDone) {
+            {
+                std::unique_lock lock(m_mutex);
+                m_queued.push_back({ curl, std::move(onDone) });
+            }
+            curl_multi_wakeup(m_multi);
+        }
+    };
+}
+
 class WebResponse::Impl {
 public:
     int m_code;
@@ -140,6 +247,9 @@ Result<matjson::Value> WebResponse::json() const {
 ByteVector WebResponse::data() const {
     return m_impl->m_data;
 }
+std::span<const uint8_t> WebResponse::dataView() const {
+    return m_impl->m_data;
+}
 Result<> WebResponse::into(std::filesystem::path const& path) const {
     return m_impl->into(path);
 }
@@ -197,11 +307,14 @@ public:
     std::optional<std::string> m_userAgent;
     std::optional<std::string> m_acceptEncodingType;
     std::optional<ByteVector> m_body;
+    std::optional<std::filesystem::path> m_intoFile;
+    utils::MiniFunction<void(std::span<const uint8_t>)> m_onChunk;
     std::optional<std::chrono::seconds> m_timeout;
     std::optional<std::pair<std::uint64_t, std::uint64_t>> m_range;
     bool m_certVerification = true;
     bool m_transferBody = true;
     bool m_followRedirects = true;
+    bool m_diskCache = false;
     std::string m_CABundleContent;
     ProxyOpts m_proxyOpts = {};
     HttpVersion m_httpVersion = HttpVersion::DEFAULT;
@@ -239,39 +352,109 @@ std::string urlParamEncode(std::string_view const input) {
 WebTask WebRequest::send(std::string_view method, std::string_view url) {
     m_impl->m_method = method;
     m_impl->m_url = url;
-    return WebTask::run([impl = m_impl](auto progress, auto hasBeenCancelled) -> WebTask::Result {
+
+    // A separate function so the request can be sent again without the disk 
+    // cache's conditional headers, if the server says the cached response is 
+    // still good but it can't be read anymore
+    auto sendRequest = [](
+        auto const& self, std::shared_ptr<Impl> impl, WebTask::PostResult finish,
+        WebTask::PostProgress progress, WebTask::HasBeenCancelled hasBeenCancelled, bool revalidate
+    ) -> void {
         // Init Curl
         auto curl = curl_easy_init();
         if (!curl) {
-            return impl->makeError(-1, "Curl not initialized");
+            return finish(impl->makeError(-1, "Curl not initialized"));
         }
 
         // todo: in the future, we might want to support downloading directly into 
         // files / in-memory streams like the old AsyncWebRequest class
 
-        // Struct that holds values for the curl callbacks
+        // Struct that holds values for the curl callbacks; this is on the 
+        // heap since the request finishes after this function has returned
         struct ResponseData {
             WebResponse response;
-            Impl* impl;
+            // Also keeps the body alive, as curl doesn't copy it
+            std::shared_ptr<Impl> impl;
             WebTask::PostProgress progress;
             WebTask::HasBeenCancelled hasBeenCancelled;
-        } responseData = {
+            CURL* curl;
+            curl_slist* headers = nullptr;
+            std::ofstream file;
+            std::optional<std::string> sinkError;
+            // Set if the response should go through the disk cache
+            std::optional<std::string> cacheURL;
+        };
+        auto responseData = std::make_unique<ResponseData>(ResponseData {
             .response = WebResponse(),
-            .impl = impl.get(),
+            .impl = impl,
             .progress = progress,
             .hasBeenCancelled = hasBeenCancelled,
-        };
+            .curl = curl,
+        });
 
-        // Store downloaded response data into a byte vector
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseData);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, +[](char* data, size_t size, size_t nmemb, void* ptr) {
-            auto& target = static_cast<ResponseData*>(ptr)->response.m_impl->m_data;
-            target.insert(target.end(), data, data + size * nmemb);
-            return size * nmemb;
+        // Store downloaded response data into a byte vector, or pass it on 
+        // to the sinks set on the request
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, responseData.get());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, +[](char* data, size_t size, size_t nmemb, void* ptr) -> size_t {
+            auto responseData = static_cast<ResponseData*>(ptr);
+            auto impl = responseData->impl.get();
+            auto chunk = std::span(reinterpret_cast<const uint8_t*>(data), size * nmemb);
+
+            // Only successful responses are streamed, so the body of an 
+            // error can still be read from the response
+            if (impl->m_intoFile || impl->m_onChunk) {
+                long code = 0;
+                curl_easy_getinfo(responseData->curl, CURLINFO_RESPONSE_CODE, &code);
+                if (200 <= code && code < 300) {
+                    if (impl->m_intoFile) {
+                        if (!responseData->file.is_open()) {
+                            responseData->file.open(*impl->m_intoFile, std::ios::out | std::ios::binary);
+                        }
+                        responseData->file.write(data, chunk.size());
+                        if (!responseData->file) {
+                            responseData->sinkError = "Couldn't write to file";
+                            // Returning less than was given aborts the transfer
+                            return 0;
+                        }
+                    }
+                    if (impl->m_onChunk) {
+                        impl->m_onChunk(chunk);
+                    }
+                    return chunk.size();
+                }
+            }
+
+            auto& target = responseData->response.m_impl->m_data;
+            target.insert(target.end(), chunk.begin(), chunk.end());
+            return chunk.size();
         });
 
+        // Add parameters to the URL
+        auto url = impl->m_url;
+        bool first = url.find('?') == std::string::npos;
+        for (auto& [key, value] : impl->m_urlParameters) {
+            url += (first ? "?" : "&") + urlParamEncode(key) + "=" + urlParamEncode(value);
+            first = false;
+        }
+
+        // Only plain requests are cached, since the others don't keep the 
+        // body around
+        if (
+            impl->m_diskCache && impl->m_method == "GET" &&
+            !impl->m_intoFile && !impl->m_onChunk && !impl->m_range
+        ) {
+            responseData->cacheURL = url;
+        }
+
         // Set headers
         curl_slist* headers = nullptr;
+        if (responseData->cacheURL && revalidate) {
+            for (auto& [name, value] : WebDiskCache::get().getConditionalHeaders(*responseData->cacheURL)) {
+                if (!impl->m_headers.contains(name)) {
+                    headers = curl_slist_append(headers, (name + ": " + value).c_str());
+                }
+            }
+        }
         for (auto& [name, value] : impl->m_headers) {
             // Sanitize header name
             auto header = name;
@@ -283,14 +466,8 @@ WebTask WebRequest::send(std::string_view method, std::string_view url) {
             headers = curl_slist_append(headers, header.c_str());
         }
         curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        responseData->headers = headers;
 
-        // Add parameters to the URL and pass it to curl
-        auto url = impl->m_url;
-        bool first = url.find('?') == std::string::npos;
-        for (auto& [key, value] : impl->m_urlParameters) {
-            url += (first ? "?" : "&") + urlParamEncode(key) + "=" + urlParamEncode(value);
-            first = false;
-        }
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
 
         // Set HTTP version
@@ -392,7 +569,7 @@ WebTask WebRequest::send(std::string_view method, std::string_view url) {
         curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L);
 
         // Get headers from the response
-        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &responseData);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, responseData.get());
         curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, (+[](char* buffer, size_t size, size_t nitems, void* ptr) {
             auto& headers = static_cast<ResponseData*>(ptr)->response.m_impl->m_headers;
             std::string line;
@@ -411,7 +588,7 @@ WebTask WebRequest::send(std::string_view method, std::string_view url) {
         }));
 
         // Track & post progress on the Promise
-        curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &responseData);
+        curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, responseData.get());
         curl_easy_setopt(curl, CURLOPT_PROGRESSFUNCTION, +[](void* ptr, double dtotal, double dnow, double utotal, double unow) -> int {
             auto data = static_cast<ResponseData*>(ptr);
 
@@ -433,35 +610,77 @@ WebTask WebRequest::send(std::string_view method, std::string_view url) {
         });
 
         // Make the actual web request
-        auto curlResponse = curl_easy_perform(curl);
-
-        // Get the response code; note that this will be invalid if the 
-        // curlResponse is not CURLE_OK
-        long code = 0;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
-        responseData.response.m_impl->m_code = static_cast<int>(code);
-
-        // Free up curl memory
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-
-        // Check if the request failed on curl's side or because of cancellation
-        if (curlResponse != CURLE_OK) {
-            if (hasBeenCancelled()) {
-                return WebTask::Cancel();
+        WebClient::get().perform(curl, [curl, data = std::move(responseData), finish, hasBeenCancelled, self](CURLcode curlResponse) mutable {
+            // Get the response code; note that this will be invalid if the 
+            // curlResponse is not CURLE_OK
+            long code = 0;
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+            data->response.m_impl->m_code = static_cast<int>(code);
+
+            // Free up curl memory
+            curl_slist_free_all(data->headers);
+            curl_easy_cleanup(curl);
+
+            // Finish writing the file the body was streamed into
+            bool streamedIntoFile = data->file.is_open();
+            if (streamedIntoFile) {
+                data->file.close();
+                if (!data->file && !data->sinkError) {
+                    data->sinkError = "Couldn't write to file";
+                }
             }
-            else {
-                return impl->makeError(-1, "Curl failed: " + std::string(curl_easy_strerror(curlResponse)));
+            // An empty body was never written, but the file should still exist
+            else if (data->impl->m_intoFile && curlResponse == CURLE_OK && 200 <= code && code < 300) {
+                std::ofstream(*data->impl->m_intoFile, std::ios::out | std::ios::binary);
+            }
+
+            // Check if the request failed on curl's side, because of 
+            // cancellation or because the body couldn't be written
+            if (curlResponse != CURLE_OK || data->sinkError) {
+                // Don't leave a partial download around
+                if (streamedIntoFile) {
+                    std::error_code ec;
+                    std::filesystem::remove(*data->impl->m_intoFile, ec);
+                }
+                if (hasBeenCancelled()) {
+                    return finish(WebTask::Cancel());
+                }
+                else if (data->sinkError) {
+                    return finish(data->impl->makeError(-1, *data->sinkError));
+                }
+                else {
+                    return finish(data->impl->makeError(-1, "Curl failed: " + std::string(curl_easy_strerror(curlResponse))));
+                }
             }
-        }
-        
-        // Check if the response was an error code
-        if (code >= 400 && code <= 600) {
-            return std::move(responseData.response);
-        }
 
-        // Otherwise resolve with success :-)
-        return std::move(responseData.response);
+            // Answer 304s from the disk cache, and cache new responses. This 
+            // touches files, so it's done off the client thread
+            if (data->cacheURL && (code == 304 || (200 <= code && code < 300))) {
+                auto job = [data = std::move(data), finish, hasBeenCancelled, self, code]() mutable {
+                    auto& response = *data->response.m_impl;
+                    if (code == 304) {
+                        auto body = WebDiskCache::get().read(*data->cacheURL);
+                        if (!body) {
+                            return self(self, data->impl, finish, data->progress, hasBeenCancelled, false);
+                        }
+                        response.m_code = 200;
+                        response.m_data = std::move(*body);
+                    }
+                    else {
+                        WebDiskCache::get().store(*data->cacheURL, response.m_headers, response.m_data);
+                    }
+                    finish(std::move(data->response));
+                };
+                return TaskExecutor::getShared()->post(std::move(job), "Web disk cache");
+            }
+
+            // Otherwise resolve with success :-) (this includes 4xx and 5xx 
+            // responses, which callers check for through the response code)
+            finish(std::move(data->response));
+        });
+    };
+    return WebTask::runWithCallback([impl = m_impl, sendRequest](auto finish, auto progress, auto hasBeenCancelled) {
+        sendRequest(sendRequest, impl, finish, progress, hasBeenCancelled, true);
     }, fmt::format("{} request to {}", method, url));
 }
 WebTask WebRequest::post(std::string_view url) {
@@ -556,11 +775,26 @@ WebRequest& WebRequest::followRedirects(bool enabled) {
     return *this;
 }
 
+WebRequest& WebRequest::diskCache(bool enabled) {
+    m_impl->m_diskCache = enabled;
+    return *this;
+}
+
 WebRequest& WebRequest::CABundleContent(std::string_view content) {
     m_impl->m_CABundleContent = content;
     return *this;
 }
 
+WebRequest& WebRequest::intoFile(std::filesystem::path const& path) {
+    m_impl->m_intoFile = path;
+    return *this;
+}
+
+WebRequest& WebRequest::onChunk(utils::MiniFunction<void(std::span<const uint8_t>)> onChunk) {
+    m_impl->m_onChunk = std::move(onChunk);
+    return *this;
+}
+
 WebRequest& WebRequest::proxyOpts(ProxyOpts const& proxyOpts) {
     m_impl->m_proxyOpts = proxyOpts;
     return *this;
@@ -621,4 +855,8 @@ std::optional<std::chrono::seconds> WebRequest::getTimeout() const {
 
 HttpVersion WebRequest::getHttpVersion() const {
     return m_impl->m_httpVersion;
-}
\ No newline at end of file
+}
+
+void utils::web::removeFromDiskCache(std::string const& url) {
+    WebDiskCache::get().remove(url);
+}
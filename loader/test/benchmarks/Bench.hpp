@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Geode/loader/Log.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace bench {
+    using Clock = std::chrono::high_resolution_clock;
+    using Duration = std::chrono::duration<double, std::nano>;
+
+    // the address of a result is stored here so the compiler can't tell 
+    // it's unused and optimize away the work that produced it
+    inline void const* volatile g_sink = nullptr;
+
+    template <class T>
+    void keep(T const& value) {
+        g_sink = static_cast<void const*>(std::addressof(value));
+    }
+
+    inline std::string formatTime(Duration time) {
+        auto ns = time.count();
+        if (ns < 1'000) return fmt::format("{:.1f}ns", ns);
+        if (ns < 1'000'000) return fmt::format("{:.2f}us", ns / 1'000);
+        if (ns < 1'000'000'000) return fmt::format("{:.2f}ms", ns / 1'000'000);
+        return fmt::format("{:.2f}s", ns / 1'000'000'000);
+    }
+
+    /**
+     * Run `body` `iterations` times and log how long one run took on average
+     */
+    template <class Body>
+    Duration measure(std::string_view name, size_t iterations, Body&& body) {
+        auto begin = Clock::now();
+        for (size_t i = 0; i < iterations; i += 1) {
+            body();
+        }
+        auto average = Duration(Clock::now() - begin) / iterations;
+        geode::log::info("{}: {}", name, formatTime(average));
+        return average;
+    }
+
+    void functions();
+    void events();
+    void web();
+    void webCache();
+    void unzip();
+    void fields();
+    void hash();
+}
@@ -0,0 +1,82 @@
+#include <Geode/loader/Event.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Bench.hpp"
+
+using namespace geode::prelude;
+
+static constexpr size_t EVENT_TYPES = 10;
+static constexpr size_t LISTENERS = 5'000;
+
+template <size_t N>
+struct BenchEvent final : public Event {};
+
+// doesn't tell its pool which event type it handles, like listeners built 
+// against older headers, so it's offered every event that's posted
+template <size_t N>
+class UntypedListener final : public EventListenerProtocol {
+    size_t& m_count;
+
+public:
+    UntypedListener(size_t& count) : m_count(count) {
+        this->enable();
+    }
+    ~UntypedListener() override {
+        this->disable();
+    }
+
+    ListenerResult handle(Event* event) override {
+        if (cast::typeinfo_cast<BenchEvent<N>*>(event)) {
+            m_count += 1;
+        }
+        return ListenerResult::Propagate;
+    }
+};
+
+template <size_t... N>
+static std::vector<std::unique_ptr<EventListenerProtocol>> addListeners(
+    bool typed, size_t& count, std::index_sequence<N...>
+) {
+    std::vector<std::unique_ptr<EventListenerProtocol>> listeners;
+    for (size_t i = 0; i < LISTENERS / EVENT_TYPES; i += 1) {
+        if (typed) {
+            (listeners.push_back(std::make_unique<EventListener<EventFilter<BenchEvent<N>>>>(
+                [&count](BenchEvent<N>*) {
+                    count += 1;
+                    return ListenerResult::Propagate;
+                }
+            )), ...);
+        }
+        else {
+            (listeners.push_back(std::make_unique<UntypedListener<N>>(count)), ...);
+        }
+    }
+    return listeners;
+}
+
+static void measurePosts(std::string_view kind, bool typed, size_t posts) {
+    size_t count = 0;
+    auto listeners = addListeners(typed, count, std::make_index_sequence<EVENT_TYPES>());
+
+    bench::measure(fmt::format("post ({}, {} posts)", kind, posts), posts, [] {
+        BenchEvent<0>().post();
+    });
+
+    auto expected = posts * (LISTENERS / EVENT_TYPES);
+    if (count != expected) {
+        log::error("Expected {} listener calls, got {}", expected, count);
+    }
+}
+
+void bench::events() {
+    log::info("Events ({} listeners over {} event types)", LISTENERS, EVENT_TYPES);
+    log::pushNest();
+
+    measurePosts("typed listeners", true, 1'000'000);
+    // these go through every listener on each post, so 1M posts would take
+    // minutes
+    measurePosts("untyped listeners", false, 10'000);
+
+    log::popNest();
+}
@@ -0,0 +1,80 @@
+#include <Geode/modify/CCNode.hpp>
+#include <future>
+#include "Bench.hpp"
+
+using namespace geode::prelude;
+
+static constexpr size_t NODES = 10'000;
+static constexpr size_t ACCESSES = 1'000'000;
+
+struct BenchFieldsNode : Modify<BenchFieldsNode, CCNode> {
+    struct Fields {
+        int value = 0;
+    };
+
+    int& value() {
+        return m_fields->value;
+    }
+};
+
+// what m_fields did before containers were looked up by class index, and
+// what mods built against older headers still do
+static int& valueByName(CCNode* node) {
+    static auto index = modifier::getFieldIndexForClass(typeid(CCNode).name());
+    auto container = modifier::FieldContainer::from(node, typeid(CCNode).name());
+    auto field = container->getField(index);
+    if (!field) {
+        field = container->setField(index, sizeof(int), [](void*) {});
+        new (field) int(0);
+    }
+    return *static_cast<int*>(field);
+}
+
+static void runOnMainThread() {
+    log::info("Node fields ({} nodes)", NODES);
+    log::pushNest();
+
+    std::vector<Ref<CCNode>> nodes;
+    nodes.reserve(NODES);
+    for (size_t i = 0; i < NODES; i += 1) {
+        nodes.push_back(CCNode::create());
+    }
+
+    // the first access creates the node's metadata, container and fields
+    size_t next = 0;
+    bench::measure("First access", NODES, [&] {
+        auto node = static_cast<BenchFieldsNode*>(nodes[next++].data());
+        node->value() = 1;
+    });
+
+    auto node = static_cast<BenchFieldsNode*>(nodes.front().data());
+    bench::measure("Access by class index (m_fields)", ACCESSES, [&] {
+        node->value() += 1;
+    });
+    bench::keep(node->value());
+
+    bench::measure("Access by class name (old headers)", ACCESSES, [&] {
+        valueByName(node) += 1;
+    });
+    bench::keep(valueByName(node));
+
+    // spread over many nodes, so the lookups miss the cache like they
+    // would in a real scene
+    next = 0;
+    bench::measure("Access across nodes (m_fields)", ACCESSES, [&] {
+        auto node = static_cast<BenchFieldsNode*>(nodes[next++ % NODES].data());
+        node->value() += 1;
+    });
+
+    log::popNest();
+}
+
+void bench::fields() {
+    // nodes can only be touched on the main thread
+    std::promise<void> done;
+    queueInMainThread([&] {
+        runOnMainThread();
+        done.set_value();
+    });
+    done.get_future().wait();
+}
@@ -0,0 +1,74 @@
+#include <Geode/utils/MiniFunction.hpp>
+#include <array>
+#include <functional>
+#include "Bench.hpp"
+
+using namespace geode::prelude;
+
+static constexpr size_t ITERATIONS = 1'000'000;
+
+static int addOne(int value) {
+    return value + 1;
+}
+
+template <template <class> class Function, class Callable>
+static void measureFunction(std::string_view type, std::string_view kind, Callable const& callable) {
+    using Func = Function<int(int)>;
+
+    bench::measure(fmt::format("{} construct ({})", type, kind), ITERATIONS, [&] {
+        Func func(callable);
+        bench::keep(func);
+    });
+
+    Func func(callable);
+    if constexpr (std::is_copy_constructible_v<Func>) {
+        bench::measure(fmt::format("{} copy ({})", type, kind), ITERATIONS, [&] {
+            Func copy(func);
+            bench::keep(copy);
+        });
+    }
+    else {
+        bench::measure(fmt::format("{} move ({})", type, kind), ITERATIONS, [&] {
+            Func moved(std::move(func));
+            func = std::move(moved);
+            bench::keep(func);
+        });
+    }
+
+    int sum = 0;
+    bench::measure(fmt::format("{} call ({})", type, kind), ITERATIONS, [&] {
+        sum = func(sum);
+    });
+    bench::keep(sum);
+}
+
+template <class Callable>
+static void measureCallable(std::string_view kind, Callable const& callable) {
+    measureFunction<std::function>("std::function", kind, callable);
+    measureFunction<utils::MiniFunction>("MiniFunction", kind, callable);
+    measureFunction<utils::MoveOnlyFunction>("MoveOnlyFunction", kind, callable);
+}
+
+void bench::functions() {
+    log::info("Functions");
+    log::pushNest();
+
+    measureCallable("captureless lambda", [](int value) {
+        return value + 1;
+    });
+    measureCallable("function pointer", &addOne);
+
+    int a = 1, b = 2;
+    measureCallable("two captured pointers", [pa = &a, pb = &b](int value) {
+        return value + *pa + *pb;
+    });
+
+    // too big to be stored inline by anything
+    std::array<int, 16> big {};
+    big.fill(1);
+    measureCallable("64 bytes captured", [big](int value) {
+        return value + big[value & 15];
+    });
+
+    log::popNest();
+}
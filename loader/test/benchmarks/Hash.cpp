@@ -0,0 +1,56 @@
+#include <picosha2.h>
+#include <sha256.hpp>
+#include "Bench.hpp"
+
+using namespace geode::prelude;
+
+static constexpr size_t SIZES_MB[] = { 1, 10, 100 };
+static constexpr size_t RUNS = 3;
+
+static SHA256::Digest hashNew(std::vector<uint8_t> const& data) {
+    SHA256 hasher;
+    hasher.update(data.data(), data.size());
+    return hasher.finish();
+}
+
+static SHA256::Digest hashOld(std::vector<uint8_t> const& data) {
+    SHA256::Digest digest;
+    picosha2::hash256(data.begin(), data.end(), digest.begin(), digest.end());
+    return digest;
+}
+
+void bench::hash() {
+    log::info("SHA-256 (backend: {})", SHA256::getBackendName());
+    log::pushNest();
+
+    for (auto mb : SIZES_MB) {
+        // not all zeroes, in case that's somehow faster
+        std::vector<uint8_t> data(mb * 1024 * 1024);
+        uint32_t state = 0x12345678;
+        for (auto& byte : data) {
+            state = state * 1664525 + 1013904223;
+            byte = static_cast<uint8_t>(state >> 24);
+        }
+
+        if (hashNew(data) != hashOld(data)) {
+            log::error("{}MB: hashes don't match", mb);
+            continue;
+        }
+
+        auto throughput = [&](Duration time) {
+            return mb / (time.count() / 1'000'000'000);
+        };
+        auto oldTime = measure(fmt::format("{}MB picosha2", mb), RUNS, [&] {
+            keep(hashOld(data));
+        });
+        auto newTime = measure(fmt::format("{}MB SHA256", mb), RUNS, [&] {
+            keep(hashNew(data));
+        });
+        log::info(
+            "{}MB: {:.0f}MB/s vs {:.0f}MB/s, {:.1f}x faster",
+            mb, throughput(oldTime), throughput(newTime), oldTime / newTime
+        );
+    }
+
+    log::popNest();
+}
@@ -0,0 +1,207 @@
+#include "LocalServer.hpp"
+
+#include <Geode/platform/platform.hpp>
+#include <algorithm>
+#include <cctype>
+#include <fmt/format.h>
+
+#ifdef GEODE_IS_WINDOWS
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    using SocketLength = int;
+    static void closeSocket(intptr_t socket) {
+        closesocket(static_cast<SOCKET>(socket));
+    }
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    using SocketLength = socklen_t;
+    static void closeSocket(intptr_t socket) {
+        close(static_cast<int>(socket));
+    }
+#endif
+
+using namespace bench;
+
+static std::string_view getReason(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 304: return "Not Modified";
+        case 404: return "Not Found";
+        default: return "Unknown";
+    }
+}
+
+LocalServer::LocalServer(Handler handler) : m_handler(std::move(handler)) {}
+
+LocalServer::~LocalServer() {
+    if (m_socket != -1) {
+        // closing the sockets makes the blocking accept and recv calls fail
+        #ifdef GEODE_IS_WINDOWS
+            shutdown(static_cast<SOCKET>(m_socket), SD_BOTH);
+        #else
+            shutdown(static_cast<int>(m_socket), SHUT_RDWR);
+        #endif
+        closeSocket(m_socket);
+    }
+    if (m_acceptThread.joinable()) {
+        m_acceptThread.join();
+    }
+    {
+        std::lock_guard lock(m_mutex);
+        for (auto connection : m_connections) {
+            #ifdef GEODE_IS_WINDOWS
+                shutdown(static_cast<SOCKET>(connection), SD_BOTH);
+            #else
+                shutdown(static_cast<int>(connection), SHUT_RDWR);
+            #endif
+        }
+    }
+    for (auto& thread : m_connectionThreads) {
+        thread.join();
+    }
+}
+
+bool LocalServer::start() {
+    #ifdef GEODE_IS_WINDOWS
+        WSADATA data;
+        if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+            return false;
+        }
+    #endif
+
+    auto sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    #ifdef GEODE_IS_WINDOWS
+        if (sock == INVALID_SOCKET) return false;
+    #else
+        if (sock < 0) return false;
+    #endif
+    m_socket = static_cast<intptr_t>(sock);
+
+    sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    // let the system pick a free port
+    addr.sin_port = 0;
+    if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(sock, 64) != 0) {
+        return false;
+    }
+    SocketLength length = sizeof(addr);
+    if (getsockname(sock, reinterpret_cast<sockaddr*>(&addr), &length) != 0) {
+        return false;
+    }
+    m_port = ntohs(addr.sin_port);
+
+    m_acceptThread = std::thread([this] {
+        this->accept();
+    });
+    return true;
+}
+
+void LocalServer::accept() {
+    while (true) {
+        auto connection = ::accept(m_socket, nullptr, nullptr);
+        #ifdef GEODE_IS_WINDOWS
+            if (connection == INVALID_SOCKET) return;
+        #else
+            if (connection < 0) return;
+        #endif
+        m_connectionCount += 1;
+
+        std::lock_guard lock(m_mutex);
+        m_connections.push_back(static_cast<intptr_t>(connection));
+        m_connectionThreads.emplace_back([this, connection] {
+            this->serve(static_cast<intptr_t>(connection));
+        });
+    }
+}
+
+void LocalServer::serve(intptr_t connection) {
+    this->respond(connection);
+
+    std::lock_guard lock(m_mutex);
+    std::erase(m_connections, connection);
+    closeSocket(connection);
+}
+
+void LocalServer::respond(intptr_t connection) {
+    std::string buffer;
+    char chunk[4096];
+    while (true) {
+        // read until the end of the headers; request bodies aren't supported
+        size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            auto read = recv(connection, chunk, sizeof(chunk), 0);
+            if (read <= 0) {
+                return;
+            }
+            buffer.append(chunk, read);
+        }
+        auto head = buffer.substr(0, headerEnd);
+        buffer.erase(0, headerEnd + 4);
+
+        Request request;
+        size_t lineEnd = head.find("\r\n");
+        auto requestLine = head.substr(0, lineEnd);
+        auto firstSpace = requestLine.find(' ');
+        auto secondSpace = requestLine.find(' ', firstSpace + 1);
+        request.method = requestLine.substr(0, firstSpace);
+        request.path = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+        while (lineEnd != std::string::npos) {
+            auto start = lineEnd + 2;
+            lineEnd = head.find("\r\n", start);
+            auto line = head.substr(start, lineEnd == std::string::npos ? std::string::npos : lineEnd - start);
+            auto colon = line.find(':');
+            auto valueStart = line.find_first_not_of(' ', colon + 1);
+            if (colon == std::string::npos || valueStart == std::string::npos) continue;
+            auto name = line.substr(0, colon);
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) {
+                return static_cast<char>(std::tolower(c));
+            });
+            request.headers[name] = line.substr(valueStart);
+        }
+        m_requestCount += 1;
+
+        auto response = m_handler(request);
+        // 304 responses never have a body
+        if (response.code == 304) {
+            response.body.clear();
+        }
+        auto out = fmt::format(
+            "HTTP/1.1 {} {}\r\nContent-Length: {}\r\n",
+            response.code, getReason(response.code), response.body.size()
+        );
+        for (auto const& [name, value] : response.headers) {
+            out += fmt::format("{}: {}\r\n", name, value);
+        }
+        out += "\r\n";
+        out += response.body;
+
+        size_t sent = 0;
+        while (sent < out.size()) {
+            auto count = send(connection, out.data() + sent, static_cast<int>(out.size() - sent), 0);
+            if (count <= 0) {
+                return;
+            }
+            sent += count;
+        }
+
+        if (request.headers["connection"] == "close") {
+            return;
+        }
+    }
+}
+
+std::string LocalServer::getURL() const {
+    return fmt::format("http://127.0.0.1:{}", m_port);
+}
+
+size_t LocalServer::getConnectionCount() const {
+    return m_connectionCount;
+}
+
+size_t LocalServer::getRequestCount() const {
+    return m_requestCount;
+}
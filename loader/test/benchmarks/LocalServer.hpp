@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bench {
+    /**
+     * A tiny HTTP/1.1 server on localhost, so web requests can be tested
+     * without going over the internet. Every connection is served on its own
+     * thread and kept alive between requests; the handler may be called from
+     * several threads at once
+     */
+    class LocalServer final {
+    public:
+        struct Request final {
+            std::string method;
+            std::string path;
+            // names are lowercase
+            std::unordered_map<std::string, std::string> headers;
+        };
+        struct Response final {
+            int code = 200;
+            std::vector<std::pair<std::string, std::string>> headers;
+            std::string body;
+        };
+        using Handler = std::function<Response(Request const&)>;
+
+    private:
+        Handler m_handler;
+        intptr_t m_socket = -1;
+        uint16_t m_port = 0;
+        std::thread m_acceptThread;
+        std::mutex m_mutex;
+        std::vector<intptr_t> m_connections;
+        std::vector<std::thread> m_connectionThreads;
+        std::atomic_size_t m_connectionCount = 0;
+        std::atomic_size_t m_requestCount = 0;
+
+        void accept();
+        void serve(intptr_t connection);
+        void respond(intptr_t connection);
+
+    public:
+        LocalServer(Handler handler);
+        ~LocalServer();
+
+        LocalServer(LocalServer const&) = delete;
+        LocalServer& operator=(LocalServer const&) = delete;
+
+        /**
+         * Start listening on a free port
+         * @returns False if the socket couldn't be set up
+         */
+        bool start();
+
+        /**
+         * The URL of the server, without a trailing slash
+         */
+        std::string getURL() const;
+        size_t getConnectionCount() const;
+        size_t getRequestCount() const;
+    };
+}
@@ -0,0 +1,67 @@
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/utils/file.hpp>
+#include "Bench.hpp"
+
+using namespace geode::prelude;
+
+static constexpr size_t ENTRIES = 10'000;
+static constexpr size_t RUNS = 3;
+
+static Result<size_t> createArchive(std::filesystem::path const& path) {
+    GEODE_UNWRAP_INTO(auto zip, file::Zip::create(path));
+    size_t bytes = 0;
+    for (size_t i = 0; i < ENTRIES; i += 1) {
+        // mostly small files with the odd bigger one, like a resource pack
+        auto size = (i % 100 == 0) ? 256 * 1024 : (i * 7919) % 8192;
+        std::string data;
+        data.reserve(size);
+        while (data.size() < size) {
+            data += fmt::format("entry {} line {}\n", i, data.size());
+        }
+        data.resize(size);
+        bytes += size;
+        GEODE_UNWRAP(zip.add(fmt::format("dir{}/file{}.txt", i % 100, i), data));
+    }
+    return Ok(bytes);
+}
+
+void bench::unzip() {
+    log::info("Unzip ({} entries)", ENTRIES);
+    log::pushNest();
+
+    auto dir = dirs::getTempDir() / "geode-benchmarks";
+    auto archive = dir / "archive.zip";
+    auto output = dir / "output";
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    (void)file::createDirectoryAll(dir);
+
+    auto created = createArchive(archive);
+    if (!created) {
+        log::error("Unable to create the archive: {}", created.unwrapErr());
+        log::popNest();
+        return;
+    }
+    log::info("Archive holds {} MB", created.unwrap() / 1024 / 1024);
+
+    for (size_t run = 0; run < RUNS; run += 1) {
+        std::filesystem::remove_all(output, ec);
+
+        auto begin = Clock::now();
+        auto res = file::Unzip::intoDir(archive, output);
+        auto time = Clock::now() - begin;
+        if (!res) {
+            log::error("Unable to extract the archive: {}", res.unwrapErr());
+            break;
+        }
+
+        size_t files = 0;
+        for (auto const& entry : std::filesystem::recursive_directory_iterator(output, ec)) {
+            files += entry.is_regular_file();
+        }
+        log::info("Unzip::intoDir: {}{}", formatTime(time), files == ENTRIES ? "" : " (entries missing!)");
+    }
+
+    std::filesystem::remove_all(dir, ec);
+    log::popNest();
+}
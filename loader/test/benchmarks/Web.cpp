@@ -0,0 +1,73 @@
+#include <Geode/utils/web.hpp>
+#include <thread>
+#include "Bench.hpp"
+#include "LocalServer.hpp"
+
+using namespace geode::prelude;
+
+static constexpr size_t BODY_SIZE = 16 * 1024;
+
+static std::string getBody(std::string_view path) {
+    auto body = std::string(path);
+    body.resize(BODY_SIZE, '.');
+    return body;
+}
+
+// web requests finish on the web client thread, so this doesn't depend on 
+// the main thread
+static bool waitFor(web::WebTask& task, std::string_view path) {
+    while (task.isPending()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto res = task.getFinishedValue();
+    return res && res->ok() && res->string().unwrapOr("") == getBody(path);
+}
+
+void bench::web() {
+    log::info("Web client");
+    log::pushNest();
+
+    LocalServer server([](LocalServer::Request const& request) {
+        LocalServer::Response response;
+        response.body = getBody(request.path);
+        return response;
+    });
+    if (!server.start()) {
+        log::error("Unable to start the local server");
+        log::popNest();
+        return;
+    }
+
+    // one after another, which should all go over the same connection
+    size_t failed = 0;
+    size_t index = 0;
+    bench::measure("sequential request", 200, [&] {
+        auto path = fmt::format("/sequential/{}", index++);
+        auto task = web::WebRequest().get(server.getURL() + path);
+        failed += !waitFor(task, path);
+    });
+    log::info("Connections opened: {}", server.getConnectionCount());
+
+    // all at once, which is limited to a few connections by the client
+    constexpr size_t CONCURRENT = 500;
+    auto connectionsBefore = server.getConnectionCount();
+    auto begin = Clock::now();
+    std::vector<std::pair<std::string, web::WebTask>> tasks;
+    for (size_t i = 0; i < CONCURRENT; i += 1) {
+        auto path = fmt::format("/concurrent/{}", i);
+        auto task = web::WebRequest().get(server.getURL() + path);
+        tasks.emplace_back(std::move(path), std::move(task));
+    }
+    for (auto& [path, task] : tasks) {
+        failed += !waitFor(task, path);
+    }
+    log::info(
+        "{} concurrent requests: {}, connections opened: {}",
+        CONCURRENT, formatTime(Clock::now() - begin), server.getConnectionCount() - connectionsBefore
+    );
+
+    if (failed) {
+        log::error("{} requests failed or got the wrong body", failed);
+    }
+    log::popNest();
+}
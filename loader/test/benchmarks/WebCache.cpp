@@ -0,0 +1,134 @@
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/utils/web.hpp>
+#include <sha256.hpp>
+#include <thread>
+#include "Bench.hpp"
+#include "LocalServer.hpp"
+
+using namespace geode::prelude;
+
+// a stand-in for the mod index, which answers conditional requests the same
+// way the real one does
+class FakeIndex final {
+    std::mutex m_mutex;
+    size_t m_version = 0;
+    size_t m_fullResponses = 0;
+    size_t m_notModifiedResponses = 0;
+
+public:
+    std::string getETag() {
+        std::unique_lock lock(m_mutex);
+        return fmt::format("\"index-{}\"", m_version);
+    }
+    std::string getBody() {
+        std::unique_lock lock(m_mutex);
+        std::string body = "{\"payload\":{\"count\":500,\"data\":[";
+        for (size_t i = 0; i < 500; i += 1) {
+            body += fmt::format("{}{{\"id\":\"fake.mod-{}\",\"version\":\"1.0.{}\"}}", i ? "," : "", i, m_version);
+        }
+        return body + "]}}";
+    }
+    void update() {
+        std::unique_lock lock(m_mutex);
+        m_version += 1;
+    }
+    std::pair<size_t, size_t> getResponseCounts() {
+        std::unique_lock lock(m_mutex);
+        return { m_fullResponses, m_notModifiedResponses };
+    }
+
+    LocalServer::Response handle(LocalServer::Request const& request) {
+        auto etag = this->getETag();
+        LocalServer::Response response;
+        response.headers.push_back({ "ETag", etag });
+
+        std::unique_lock lock(m_mutex);
+        auto it = request.headers.find("if-none-match");
+        if (it != request.headers.end() && it->second == etag) {
+            m_notModifiedResponses += 1;
+            response.code = 304;
+            return response;
+        }
+        m_fullResponses += 1;
+        lock.unlock();
+        response.body = this->getBody();
+        return response;
+    }
+};
+
+static std::optional<std::string> fetch(std::string const& url) {
+    auto task = web::WebRequest().diskCache(true).get(url);
+    while (task.isPending()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto res = task.getFinishedValue();
+    if (!res || !res->ok()) {
+        return std::nullopt;
+    }
+    return res->string().ok();
+}
+
+// like the cache's files getting deleted by something else; bodies are
+// stored under the hash of their url, so nothing else in the cache is touched
+static void removeCachedBody(std::string const& url) {
+    SHA256 hasher;
+    hasher.update(url.data(), url.size());
+    std::error_code ec;
+    std::filesystem::remove(dirs::getGeodeDir() / "web-cache" / SHA256::toHex(hasher.finish()), ec);
+}
+
+void bench::webCache() {
+    log::info("Web disk cache");
+    log::pushNest();
+
+    FakeIndex index;
+    LocalServer server([&](LocalServer::Request const& request) {
+        return index.handle(request);
+    });
+    if (!server.start()) {
+        log::error("Unable to start the local server");
+        log::popNest();
+        return;
+    }
+    auto url = server.getURL() + "/v1/mods";
+
+    size_t failed = 0;
+    auto check = [&](std::string_view what, std::optional<std::string> const& body, size_t full, size_t notModified) {
+        auto counts = index.getResponseCounts();
+        if (body != index.getBody() || counts != std::pair(full, notModified)) {
+            log::error(
+                "{}: got {} body, server sent {} full and {} not modified responses (expected {} and {})",
+                what, body == index.getBody() ? "the right" : "the wrong",
+                counts.first, counts.second, full, notModified
+            );
+            failed += 1;
+        }
+    };
+
+    check("Cold request", fetch(url), 1, 0);
+    check("Revalidated request", fetch(url), 1, 1);
+
+    constexpr size_t REVALIDATIONS = 100;
+    measure("revalidated request", REVALIDATIONS, [&] {
+        keep(fetch(url));
+    });
+    check("Repeated revalidation", fetch(url), 1, 2 + REVALIDATIONS);
+
+    // the server says the cached body is fine, but there's nothing to read,
+    // so the request has to be sent again without the conditional headers
+    removeCachedBody(url);
+    check("Lost cached body", fetch(url), 2, 3 + REVALIDATIONS);
+
+    index.update();
+    check("Updated index", fetch(url), 3, 3 + REVALIDATIONS);
+    check("Updated index revalidated", fetch(url), 3, 4 + REVALIDATIONS);
+
+    // the server's port is different every run, so the entry would never be
+    // used again
+    web::removeFromDiskCache(url);
+
+    if (failed) {
+        log::error("{} checks failed", failed);
+    }
+    log::popNest();
+}
@@ -0,0 +1,26 @@
+#include <Geode/Loader.hpp>
+#include <thread>
+#include "Bench.hpp"
+
+using namespace geode::prelude;
+
+// some of these take a while, so they only run when the game is launched 
+// with --geode:geode.benchmarks.run
+$on_mod(Loaded) {
+    if (!Mod::get()->getLaunchFlag("run")) {
+        return;
+    }
+    std::thread([] {
+        log::info("Running benchmarks");
+        log::pushNest();
+        bench::functions();
+        bench::events();
+        bench::web();
+        bench::webCache();
+        bench::unzip();
+        bench::fields();
+        bench::hash();
+        log::popNest();
+        log::info("Benchmarks done");
+    }).detach();
+}
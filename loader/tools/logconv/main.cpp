@@ -0,0 +1,275 @@
+// Converts binary logs written with the binary-log launch flag back into
+// text or JSON lines, optionally filtered by mod, severity and time
+
+#include <BinaryLog.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace geode::log;
+
+namespace {
+    constexpr char const* SEVERITY_NAMES[] = { "DEBUG", "INFO ", "WARN ", "ERROR" };
+    constexpr char const* SEVERITY_IDS[] = { "debug", "info", "warn", "error" };
+
+    struct Options {
+        std::string input;
+        bool json = false;
+        std::unordered_set<std::string> mods;
+        int minSeverity = 0;
+        std::optional<int64_t> from;
+        std::optional<int64_t> to;
+    };
+
+    void printUsage() {
+        std::cerr <<
+            "Usage: geode-logconv <log" << binary::FILE_EXTENSION << "> [options]\n"
+            "Options:\n"
+            "  --json              Print one JSON object per line instead of text\n"
+            "  --mod <id>          Only print logs from this mod; can be repeated\n"
+            "  --severity <level>  Only print logs of this severity or above\n"
+            "                      (debug, info, warn or error)\n"
+            "  --from <time>       Only print logs from this time on\n"
+            "  --to <time>         Only print logs up to this time\n"
+            "Times are either unix timestamps in seconds or local times formatted\n"
+            "as YYYY-MM-DDTHH:MM:SS\n";
+    }
+
+    std::optional<int> parseSeverity(std::string const& str) {
+        if (str == "debug") return 0;
+        if (str == "info") return 1;
+        if (str == "warn" || str == "warning") return 2;
+        if (str == "error") return 3;
+        return std::nullopt;
+    }
+
+    // returns microseconds since the unix epoch, same as in the log
+    std::optional<int64_t> parseTime(std::string const& str) {
+        if (str.find_first_not_of("0123456789") == std::string::npos) {
+            return std::stoll(str) * 1'000'000;
+        }
+        std::tm tm = {};
+        tm.tm_isdst = -1;
+        std::istringstream stream(str);
+        stream >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+        if (stream.fail()) {
+            return std::nullopt;
+        }
+        return static_cast<int64_t>(std::mktime(&tm)) * 1'000'000;
+    }
+
+    std::string formatTime(int64_t micros) {
+        auto seconds = static_cast<std::time_t>(micros / 1'000'000);
+        std::tm tm = *std::localtime(&seconds);
+        char buf[32];
+        std::strftime(buf, sizeof(buf), "%H:%M:%S", &tm);
+        return buf;
+    }
+
+    std::string escapeJson(std::string_view str) {
+        std::string out;
+        out.reserve(str.size());
+        for (auto c : str) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                        out += buf;
+                    }
+                    else {
+                        out += c;
+                    }
+                    break;
+            }
+        }
+        return out;
+    }
+
+    std::optional<Options> parseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; i += 1) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::optional<std::string> {
+                if (i + 1 >= argc) {
+                    std::cerr << "Missing value for " << arg << "\n";
+                    return std::nullopt;
+                }
+                return argv[++i];
+            };
+            if (arg == "--json") {
+                options.json = true;
+            }
+            else if (arg == "--mod") {
+                auto value = next();
+                if (!value) return std::nullopt;
+                options.mods.insert(*value);
+            }
+            else if (arg == "--severity") {
+                auto value = next();
+                if (!value) return std::nullopt;
+                auto severity = parseSeverity(*value);
+                if (!severity) {
+                    std::cerr << "Invalid severity \"" << *value << "\"\n";
+                    return std::nullopt;
+                }
+                options.minSeverity = *severity;
+            }
+            else if (arg == "--from" || arg == "--to") {
+                auto value = next();
+                if (!value) return std::nullopt;
+                auto time = parseTime(*value);
+                if (!time) {
+                    std::cerr << "Invalid time \"" << *value << "\"\n";
+                    return std::nullopt;
+                }
+                (arg == "--from" ? options.from : options.to) = time;
+            }
+            else if (arg.starts_with("--") || !options.input.empty()) {
+                std::cerr << "Unknown argument \"" << arg << "\"\n";
+                return std::nullopt;
+            }
+            else {
+                options.input = arg;
+            }
+        }
+        if (options.input.empty()) {
+            return std::nullopt;
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv) {
+    auto options = parseOptions(argc, argv);
+    if (!options) {
+        printUsage();
+        return 1;
+    }
+
+    std::ifstream file(options->input, std::ios::binary);
+    if (!file) {
+        std::cerr << "Unable to open " << options->input << "\n";
+        return 1;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), {});
+
+    binary::Reader reader(data);
+    if (!reader.readHeader()) {
+        std::cerr << options->input << " is not a binary log, or is from an unsupported version\n";
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, std::string_view> strings;
+    auto lookup = [&](uint32_t id) {
+        auto it = strings.find(id);
+        return it != strings.end() ? it->second : std::string_view("?");
+    };
+
+    std::string out;
+    while (!reader.atEnd()) {
+        binary::RecordType type;
+        if (!reader.read(type)) {
+            break;
+        }
+
+        if (type == binary::RecordType::String) {
+            uint32_t id;
+            std::string_view value;
+            if (!reader.read(id) || !reader.read(value)) {
+                break;
+            }
+            strings[id] = value;
+            continue;
+        }
+        if (type != binary::RecordType::Log) {
+            std::cerr << "Unknown record type " << static_cast<int>(type) << ", stopping\n";
+            return 1;
+        }
+
+        int64_t time;
+        uint8_t severity;
+        uint32_t sourceID, threadID;
+        int32_t nestCount;
+        std::string_view message;
+        if (
+            !reader.read(time) || !reader.read(severity) || !reader.read(sourceID) ||
+            !reader.read(threadID) || !reader.read(nestCount) || !reader.read(message)
+        ) {
+            break;
+        }
+        // version 1 logs only have the mod's name
+        uint32_t modID = sourceID;
+        if (reader.getVersion() >= 2 && !reader.read(modID)) {
+            break;
+        }
+
+        auto source = lookup(sourceID);
+        auto thread = lookup(threadID);
+        auto mod = lookup(modID);
+        if (severity < options->minSeverity) continue;
+        if (options->from && time < *options->from) continue;
+        if (options->to && time > *options->to) continue;
+        if (!options->mods.empty() && !options->mods.contains(std::string(mod))) continue;
+
+        out.clear();
+        if (options->json) {
+            out += "{\"time\":";
+            out += std::to_string(time);
+            out += ",\"severity\":\"";
+            out += severity < 4 ? SEVERITY_IDS[severity] : "unknown";
+            out += "\",\"mod\":\"";
+            out += escapeJson(mod);
+            out += "\",\"source\":\"";
+            out += escapeJson(source);
+            out += "\",\"thread\":\"";
+            out += escapeJson(thread);
+            out += "\",\"nest\":";
+            out += std::to_string(nestCount);
+            out += ",\"message\":\"";
+            out += escapeJson(message);
+            out += "\"}\n";
+        }
+        else {
+            out += formatTime(time);
+            out += ' ';
+            out += severity < 4 ? SEVERITY_NAMES[severity] : "?????";
+            if (!thread.empty()) {
+                out += " [";
+                out += thread;
+                out += "]";
+            }
+            out += " [";
+            out += source;
+            out += "]: ";
+            // the nest count includes the widths of the names, same as in
+            // the text logs
+            auto indent = nestCount - static_cast<int32_t>(source.size() + thread.size());
+            if (nestCount > 0 && indent > 0) {
+                out.append(indent, ' ');
+            }
+            out += message;
+            out += '\n';
+        }
+        std::cout << out;
+    }
+    if (!reader.atEnd()) {
+        std::cerr << "Log ended with an incomplete record\n";
+    }
+    return 0;
+}